@@ -1,13 +1,19 @@
+#include <array>
 #include <cassert>
+#include <cstdlib>
 #include <cstdio>
 #include <vector>
 #include <numeric>
+#include <string>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 
+// recompute blur over the halo of sharpen instead of materializing the blurred image
+#define CELERITY_STD_ENABLE_OVERLAPPED_TILING
+
 #include "../../include/algorithm.h"
 #include "../../include/buffer_traits.h"
 #include "../../include/fusion_helper.h"
@@ -16,6 +22,9 @@ constexpr int FILTER_SIZE = 16;
 constexpr float sigma = 3.f;
 constexpr float PI = 3.141592f;
 
+// work groups of the staged kernels, which read the tile of their group and its halo through local memory
+constexpr size_t GROUP_SIZE = 16;
+
 std::vector<cl::sycl::float3> load_image(std::string filename, int &width, int &height, int &channels)
 {
 	std::vector<cl::sycl::float3> image_input;
@@ -45,6 +54,13 @@ namespace kernels
 using f = celerity::algorithm::traits::buffer_traits<float, 2>;
 using f3 = celerity::algorithm::traits::buffer_traits<cl::sycl::float3, 2>;
 
+// pixels of raw images, which hold 8-bit RGB triples in row-major order without a header
+using rgb8 = std::array<uint8_t, 3>;
+
+constexpr auto to_float3 = [](rgb8 c) -> cl::sycl::float3 {
+	return {c[0] / 255.f, c[1] / 255.f, c[2] / 255.f};
+};
+
 constexpr auto gen_gauss = [](cl::sycl::item<2> item) {
 	const auto x = item.get_id(1) - (FILTER_SIZE / 2);
 	const auto y = item.get_id(0) - (FILTER_SIZE / 2);
@@ -52,12 +68,16 @@ constexpr auto gen_gauss = [](cl::sycl::item<2> item) {
 	return cl::sycl::exp(-1.f * (x * x + y * y) / (2 * sigma * sigma)) / (2 * PI * sigma * sigma);
 };
 
-constexpr auto blur = [](const f3::chunk<FILTER_SIZE, FILTER_SIZE> &in, const f::all &gauss) {
+// the image and the filter are read straight from their buffers
+template <typename Chunk>
+constexpr auto blur = [](const Chunk &in, const f::device_all &gauss) {
 	return in.discern(cl::sycl::float3{},
 					  [&]() { return std::inner_product(begin(in), end(in), begin(gauss), cl::sycl::float3{}); });
 };
 
-constexpr auto sharpen = [](f3::chunk<3, 3> in) {
+// reads the blurred image through the type erased chunk when it is recomputed in tiles
+template <typename Chunk>
+constexpr auto sharpen = [](const Chunk &in) {
 	constexpr std::array<int, 9> weights = {
 		0, -1, 0,
 		-1, 0, -1,
@@ -82,18 +102,51 @@ constexpr auto to_uint8 = [](cl::sycl::float3 c) -> uchar3 {
 		static_cast<u_char>(c.z() * 255.f)};
 };
 
+constexpr auto to_rgb8 = [](uchar3 c) -> rgb8 {
+	return {c.x(), c.y(), c.z()};
+};
+
 } // namespace kernels
 
 int main(int argc, char *argv[])
 {
-	if (argc != 2)
+	// raw images are read and written by every node for its own part instead of passing through the master,
+	// e.g. convert -depth 8 in.png rgb:in.rgb and convert -size <width>x<height> -depth 8 rgb:output.rgb output.png
+	const auto raw = argc >= 2 && std::string{"--raw"} == argv[1];
+	const auto args = raw ? 5 : 2;
+	const auto staged = argc == args + 1 && std::string{"--staged"} == argv[args];
+
+	if (argc != args && !staged)
 	{
-		fprintf(stderr, "Usage: %s <image file>\n", argv[0]);
+		fprintf(stderr, "Usage: %s <image file> [--staged]\n", argv[0]);
+		fprintf(stderr, "       %s --raw <width> <height> <rgb file> [--staged]\n", argv[0]);
 		return EXIT_FAILURE;
 	}
 
 	int image_width = 0, image_height = 0, image_channels = 0;
-	auto image_input = load_image(argv[1], image_width, image_height, image_channels);
+	std::vector<cl::sycl::float3> image_input;
+
+	if (raw)
+	{
+		image_width = std::atoi(argv[2]);
+		image_height = std::atoi(argv[3]);
+
+		if (image_width <= 0 || image_height <= 0)
+		{
+			fprintf(stderr, "Invalid image size %s x %s\n", argv[2], argv[3]);
+			return EXIT_FAILURE;
+		}
+	}
+	else
+	{
+		image_input = load_image(argv[1], image_width, image_height, image_channels);
+	}
+
+	if (staged && (static_cast<size_t>(image_width) % GROUP_SIZE != 0 || static_cast<size_t>(image_height) % GROUP_SIZE != 0))
+	{
+		fprintf(stderr, "Staged kernels require an image whose sides are multiples of %zu\n", GROUP_SIZE);
+		return EXIT_FAILURE;
+	}
 
 	using namespace celerity;
 	using namespace algorithm;
@@ -113,26 +166,47 @@ int main(int argc, char *argv[])
 	// 			   transform<class _5>(kernels::to_uint8) |
 	// 			   submit_to(queue);
 
-	auto seq = make_buffer(image_input.data(), image_range) |
-			   transform<class _1>(kernels::blur) << generate_n<class _2>(gauss_range, kernels::gen_gauss) |
-			   transform<class _3>(kernels::sharpen) |
-			   transform<class _4>(kernels::delimit) |
-			   transform<class _5>(kernels::to_uint8);
+	using namespace kernels;
 
-	//static_assert(traits::size_v<decltype(terminate(seq))> == 4);
-	//static_assert(traits::size_v<decltype(fuse(terminate(seq)))> == 2);
+	auto image = raw ? from_file<rgb8>(argv[4], image_range) | transform<class _0>(to_float3) | submit_to(queue)
+					 : make_buffer(image_input.data(), image_range);
 
-	auto out_buf = seq | submit_to(queue);
+	// by default blur is recomputed over the halo of sharpen instead of materializing the blurred image,
+	// the staged kernels materialize it but read every element of their inputs from global memory once per group
+	auto out_buf = [&]() {
+		if (staged)
+		{
+			return image |
+				   transform<class _1s, GROUP_SIZE, GROUP_SIZE>(blur<f3::device_chunk<FILTER_SIZE, FILTER_SIZE>>) << generate_n<class _2s>(gauss_range, gen_gauss) |
+				   transform<class _3s, GROUP_SIZE, GROUP_SIZE>(sharpen<f3::device_chunk<3, 3>>) |
+				   transform<class _4s>(delimit) |
+				   transform<class _5s>(to_uint8) |
+				   submit_to(queue);
+		}
 
-	//std::cout << util::to_string(fuse(terminate(seq))) << std::endl;
+		return image |
+			   transform<class _1>(blur<f3::device_chunk<FILTER_SIZE, FILTER_SIZE>>) << generate_n<class _2>(gauss_range, gen_gauss) |
+			   transform<class _3>(sharpen<f3::chunk<3, 3>>) |
+			   transform<class _4>(delimit) |
+			   transform<class _5>(to_uint8) |
+			   submit_to(queue);
+	}();
+
+	if (raw)
+	{
+		out_buf | transform<class _6>(to_rgb8) | to_file("./output.rgb") | submit_to(queue);
+	}
 
 	queue.slow_full_sync();
 	celerity::experimental::bench::end("main program");
 
-	std::vector<std::array<uint8_t, 3>>
-		image_output(image_width * image_height);
-	copy(master_blocking(queue), begin(out_buf), end(out_buf), image_output.data());
-	stbi_write_png("./output.png", image_width, image_height, 3, image_output.data(), 0);
+	if (!raw)
+	{
+		std::vector<std::array<uint8_t, 3>>
+			image_output(image_width * image_height);
+		copy(master_blocking(queue), begin(out_buf), end(out_buf), image_output.data());
+		stbi_write_png("./output.png", image_width, image_height, 3, image_output.data(), 0);
+	}
 
 	return EXIT_SUCCESS;
 }
@@ -11,6 +11,12 @@
 
 constexpr auto MAT_SIZE = 1024;
 
+// the multiplications are launched in work groups of this size, which stage tiles of the rows and columns they read
+// through local memory: a work item of matmul_orig reads 2 * MAT_SIZE elements from global memory,
+// here a group of 16x16 work items reads 2 * 16 * MAT_SIZE elements, a sixteenth per work item,
+// both examples log the duration of their "main program" for comparing the two with the same MAT_SIZE
+constexpr size_t TILE_SIZE = 16;
+
 using namespace celerity;
 using namespace algorithm;
 using namespace aliases;
@@ -25,7 +31,9 @@ constexpr auto gen_b = [](cl::sycl::item<2> item) {
 	return gen_a(item) * 2;
 };
 
-constexpr auto multiply = [](const slice_f<1> &a, const slice_f<0> &b) {
+using f = celerity::algorithm::traits::buffer_traits<float, 2>;
+
+constexpr auto multiply = [](const f::device_slice<1> &a, const f::device_slice<0> &b) {
 	return std::inner_product(begin(a), end(a), begin(b), 0.f);
 };
 } // namespace kernels
@@ -58,8 +66,8 @@ int main(int argc, char *argv[])
 
 		auto out_buf =
 			generate_n<class _2>(mat_range, kernels::gen_a) |
-			transform<class _3>(kernels::multiply) << mat_b |
-			transform<class _4>(kernels::multiply) << mat_b |
+			transform<class _3, TILE_SIZE, TILE_SIZE>(kernels::multiply) << mat_b |
+			transform<class _4, TILE_SIZE, TILE_SIZE>(kernels::multiply) << mat_b |
 			submit_to(queue);
 
 		master_task(algorithm::master(queue), [=, &verification_passed](auto &cgh) {
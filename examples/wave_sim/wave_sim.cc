@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <fstream>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #pragma clang diagnostic ignored "-Wunused-result"
@@ -45,18 +47,26 @@ struct update_config
 	static constexpr float c = 1.f;
 };
 
-template <typename Config, typename KernelName>
-auto step(float dt, cl::sycl::float2 delta)
-{
-	using namespace celerity::algorithm;
+// single steps read the current step straight from its buffer,
+// blocked steps read intermediate steps from private memory and need the type erased chunk
+using device_stencil = celerity::algorithm::traits::buffer_traits<float, 2>::device_chunk<1, 1>;
+using blocked_stencil = celerity::algorithm::chunk<float, 1, 1>;
 
-	const auto step = [=](float v_up, const chunk<float, 1, 1> &v_u) {
+template <typename Config, typename Chunk>
+auto step_fn(float dt, cl::sycl::float2 delta)
+{
+	return [=](float v_up, const Chunk &v_u) {
 		const float lap = (dt / delta.y()) * (dt / delta.y()) * ((v_u[{1, 0}] - *v_u) - (*v_u - v_u[{-1, 0}])) + (dt / delta.x()) * (dt / delta.x()) * ((v_u[{0, 1}] - *v_u) - (*v_u - v_u[{0, -1}]));
 
 		return Config::a * 2 * *v_u - Config::b * v_up + Config::c * lap;
 	};
+}
 
-	return transform<KernelName>(step);
+template <typename Config, typename KernelName>
+auto step(float dt, cl::sycl::float2 delta)
+{
+	using namespace celerity::algorithm;
+	return transform<KernelName>(step_fn<Config, device_stencil>(dt, delta));
 }
 
 auto initialize(float dt, cl::sycl::float2 delta)
@@ -69,24 +79,43 @@ auto update(float dt, cl::sycl::float2 delta)
 	return step<update_config, class update>(dt, delta);
 }
 
-template <typename T>
-void store(celerity::distr_queue &queue, celerity::buffer<T, 2> &up, std::vector<std::vector<float>> &result_frames)
+// number of steps advanced by a single submission between two snapshots
+constexpr size_t blocked_steps = 4;
+
+// the kernels computing the steps blocked_steps - 1 and blocked_steps after the current one in private memory,
+// they become the previous and the current step of the next submission
+auto update_blocked_prev(float dt, cl::sycl::float2 delta)
 {
 	using namespace celerity::algorithm;
+	return transform<class update_blocked_prev>(time_blocked_pair<blocked_steps>(step_fn<update_config, blocked_stencil>(dt, delta)).first);
+}
 
-	const auto range = up.get_range();
-	std::vector<float> v(range.size());
+auto update_blocked_curr(float dt, cl::sycl::float2 delta)
+{
+	using namespace celerity::algorithm;
+	return transform<class update_blocked_curr>(time_blocked_pair<blocked_steps>(step_fn<update_config, blocked_stencil>(dt, delta)).second);
+}
 
-	copy(master_blocking(queue), up, v.data());
+template <typename T>
+void store(celerity::distr_queue &queue, celerity::buffer<T, 2> &up, celerity::algorithm::snapshot_writer<T> &writer)
+{
+	using namespace celerity::algorithm;
 
-	result_frames.emplace_back(std::move(v));
+	// the frame is streamed to the master and written by the writer thread while the simulation continues
+	snapshot(master(queue), up, writer);
 }
 
-void write_csv(size_t N, std::vector<std::vector<float>> &result_frames)
+template <typename T>
+void store_raw(celerity::distr_queue &queue, celerity::buffer<T, 2> &up, size_t i)
 {
-	std::ofstream os;
-	os.open("wave_sim_result.csv", std::ios_base::out | std::ios_base::binary);
+	using namespace celerity::algorithm;
 
+	// every node writes its own rows of the frame to the file, nothing is gathered on the master
+	up | to_file("wave_sim_result_" + std::to_string(i) + ".bin") | submit_to(queue);
+}
+
+void write_csv_header(std::ostream &os, size_t N)
+{
 	os << "t";
 	for (size_t y = 0; y < N; ++y)
 	{
@@ -96,21 +125,20 @@ void write_csv(size_t N, std::vector<std::vector<float>> &result_frames)
 		}
 	}
 	os << "\n";
+}
 
-	size_t i = 0;
-	for (auto &frame : result_frames)
+void write_csv_row(std::ostream &os, size_t N, size_t i, const float *frame)
+{
+	os << i;
+	for (size_t y = 0; y < N; ++y)
 	{
-		os << i++;
-		for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
 		{
-			for (size_t x = 0; x < N; ++x)
-			{
-				auto v = frame[y * N + x];
-				os << "," << v;
-			}
+			auto v = frame[y * N + x];
+			os << "," << v;
 		}
-		os << "\n";
 	}
+	os << "\n";
 }
 
 struct wave_sim_config
@@ -124,6 +152,12 @@ struct wave_sim_config
 	// "Sample" a frame every X iterations
 	// (0 = don't produce any output)
 	unsigned output_sample_rate = 3;
+
+	// Write delta compressed binary frames instead of CSV
+	bool compress_output = false;
+
+	// Write every frame to its own raw binary file instead of CSV
+	bool raw_output = false;
 };
 
 using arg_vector = std::vector<const char *>;
@@ -161,6 +195,16 @@ int main(int argc, char *argv[])
 				++it;
 				continue;
 			}
+			if (std::string{"--compress"} == *it)
+			{
+				result.compress_output = true;
+				continue;
+			}
+			if (std::string{"--raw"} == *it)
+			{
+				result.raw_output = true;
+				continue;
+			}
 			std::cerr << "Unknown argument: " << *it << std::endl;
 		}
 		return result;
@@ -180,8 +224,37 @@ int main(int argc, char *argv[])
 	auto is_master = false;
 	on_master([&]() { is_master = true; });
 
-	// TODO: We could allocate the required size at the beginning
-	std::vector<std::vector<float>> result_frames;
+	// Frames are written as they come in, at most a few of them are kept in memory at any time
+	std::ofstream os;
+	if (is_master && cfg.output_sample_rate > 0 && !cfg.raw_output)
+	{
+		if (cfg.compress_output)
+		{
+			os.open("wave_sim_result.bin", std::ios_base::out | std::ios_base::binary);
+		}
+		else
+		{
+			os.open("wave_sim_result.csv", std::ios_base::out | std::ios_base::binary);
+			write_csv_header(os, cfg.N);
+		}
+	}
+
+	// Compressed frames are prefixed with their size in bytes
+	snapshot_writer<float> writer(
+		[&](size_t i, const char *bytes, size_t size) {
+			if (cfg.compress_output)
+			{
+				const auto frame_size = static_cast<uint64_t>(size);
+				os.write(reinterpret_cast<const char *>(&frame_size), sizeof(frame_size));
+				os.write(bytes, size);
+			}
+			else
+			{
+				write_csv_row(os, cfg.N, i, reinterpret_cast<const float *>(bytes));
+			}
+		},
+		4, cfg.compress_output ? snapshot_compression::delta : snapshot_compression::none);
+
 	{
 		celerity::distr_queue queue;
 		cl::sycl::range buf_range = cl::sycl::range<2>(cfg.N, cfg.N);
@@ -198,41 +271,71 @@ int main(int argc, char *argv[])
 				  initialize(cfg.dt, {cfg.dx, cfg.dy}) << u |
 				  submit_to(queue);
 
+		// blocked submissions write both of the last two steps, so they need a second pair of buffers
+		celerity::buffer<float, 2> up_next{buf_range};
+		celerity::buffer<float, 2> u_next{buf_range};
+
 		// We need to rotate buffers. Since we cannot swap them directly, we use pointers instead.
 		// TODO: Make buffers swappable
 		auto up_ref = &up;
 		auto u_ref = &u;
+		auto up_next_ref = &up_next;
+		auto u_next_ref = &u_next;
+
+		const auto record = [&](size_t i) {
+			if (cfg.raw_output)
+			{
+				store_raw(queue, *u_ref, i);
+			}
+			else
+			{
+				store(queue, *u_ref, writer);
+			}
+		};
 
 		// Store initial state
 		if (cfg.output_sample_rate > 0)
 		{
-			store(queue, *u_ref, result_frames);
+			record(0);
 		}
 
 		auto t = 0.0;
 		size_t i = 0;
 		while (t < cfg.T)
 		{
-			*up_ref | update(cfg.dt, {cfg.dx, cfg.dy}) << *u_ref | *up_ref | submit_to(queue);
+			// steps until the end of the simulation and until the next snapshot
+			const auto remaining = static_cast<size_t>(std::ceil((cfg.T - t) / cfg.dt));
+			const auto until_snapshot = cfg.output_sample_rate != 0 ? cfg.output_sample_rate - i % cfg.output_sample_rate : remaining;
 
-			if (cfg.output_sample_rate != 0 && ++i % cfg.output_sample_rate == 0)
+			if (std::min(remaining, until_snapshot) >= blocked_steps)
 			{
-				store(queue, *up_ref, result_frames);
+				*up_ref | update_blocked_prev(cfg.dt, {cfg.dx, cfg.dy}) << *u_ref | *up_next_ref | submit_to(queue);
+				*up_ref | update_blocked_curr(cfg.dt, {cfg.dx, cfg.dy}) << *u_ref | *u_next_ref | submit_to(queue);
+
+				std::swap(up_ref, up_next_ref);
+				std::swap(u_ref, u_next_ref);
+
+				i += blocked_steps;
+				t += blocked_steps * cfg.dt;
 			}
+			else
+			{
+				*up_ref | update(cfg.dt, {cfg.dx, cfg.dy}) << *u_ref | *up_ref | submit_to(queue);
 
-			std::swap(u_ref, up_ref);
-			t += cfg.dt;
-		}
-	}
+				std::swap(u_ref, up_ref);
 
-	if (is_master)
-		if (cfg.output_sample_rate > 0)
-		{
-			std::cout << "writing output..." << std::endl;
+				++i;
+				t += cfg.dt;
+			}
 
-			// TODO: Consider writing results to disk as they're coming in, instead of just at the end
-			write_csv(cfg.N, result_frames);
+			if (cfg.output_sample_rate != 0 && i % cfg.output_sample_rate == 0)
+			{
+				record(i);
+			}
 		}
 
+		queue.slow_full_sync();
+	}
+
 	return EXIT_SUCCESS;
 }
@@ -13,8 +13,8 @@ class slice_iterator
 public:
     static constexpr auto rank = 1;
 
-    template <typename T, size_t Dim, bool Transposed>
-    slice_iterator(const slice<T, Dim, Transposed> &slice, cl::sycl::id<rank> pos,
+    template <typename Accessor, size_t Dim, bool Transposed>
+    slice_iterator(const basic_slice<Accessor, Dim, Transposed> &slice, cl::sycl::id<rank> pos,
                     cl::sycl::range<rank> range)
         : it_(pos, range), slice_(slice) {}
 
@@ -43,19 +43,19 @@ private:
     const SliceType &slice_;
 };
 
-template <typename T, size_t Dim, bool Transposed>
-slice_iterator(const slice<T, Dim, Transposed> &, cl::sycl::id<1>,
+template <typename Accessor, size_t Dim, bool Transposed>
+slice_iterator(const basic_slice<Accessor, Dim, Transposed> &, cl::sycl::id<1>,
                 cl::sycl::range<1>)
-    ->slice_iterator<slice<T, Dim, Transposed>>;
+    ->slice_iterator<basic_slice<Accessor, Dim, Transposed>>;
 
-template <typename T, size_t Dim, bool Transposed>
-auto begin(const slice<T, Dim, Transposed> &s)
+template <typename Accessor, size_t Dim, bool Transposed>
+auto begin(const basic_slice<Accessor, Dim, Transposed> &s)
 {
     return slice_iterator{s, {}, s.get_range()};
 }
 
-template <typename T, size_t Dim, bool Transposed>
-auto end(const slice<T, Dim, Transposed> &s)
+template <typename Accessor, size_t Dim, bool Transposed>
+auto end(const basic_slice<Accessor, Dim, Transposed> &s)
 {
     return slice_iterator{s, s.get_range(), s.get_range()};
 }
@@ -64,8 +64,8 @@ template <typename ChunkType, int Rank>
 class chunk_iterator
 {
 public:
-    template <typename T, size_t... Extents>
-    chunk_iterator(const chunk<T, Extents...> &chunk, cl::sycl::id<Rank> center,
+    template <typename Accessor, size_t... Extents>
+    chunk_iterator(const basic_chunk<Accessor, Extents...> &chunk, cl::sycl::id<Rank> center,
                     cl::sycl::id<Rank> pos)
         : offset_((Extents / 2)...), center_(center), it_(pos, {Extents...}),
             chunk_(chunk) {}
@@ -102,20 +102,20 @@ private:
     const ChunkType &chunk_;
 };
 
-template <typename T, int Rank, size_t... Extents>
-chunk_iterator(const chunk<T, Extents...> &, cl::sycl::id<Rank>,
+template <typename Accessor, int Rank, size_t... Extents>
+chunk_iterator(const basic_chunk<Accessor, Extents...> &, cl::sycl::id<Rank>,
                 cl::sycl::id<Rank>)
-    ->chunk_iterator<chunk<T, Extents...>, Rank>;
+    ->chunk_iterator<basic_chunk<Accessor, Extents...>, Rank>;
 
-template <typename T, size_t... Extents>
-auto begin(const chunk<T, Extents...> &chunk)
+template <typename Accessor, size_t... Extents>
+auto begin(const basic_chunk<Accessor, Extents...> &chunk)
 {
     return chunk_iterator{chunk, chunk.item().get_id(),
                             cl::sycl::id<sizeof...(Extents)>{}};
 }
 
-template <typename T, size_t... Extents>
-auto end(const chunk<T, Extents...> &chunk)
+template <typename Accessor, size_t... Extents>
+auto end(const basic_chunk<Accessor, Extents...> &chunk)
 {
     return chunk_iterator{chunk, chunk.item().get_id(),
                             cl::sycl::id<sizeof...(Extents)>{Extents...}};
@@ -125,18 +125,19 @@ template <typename AllType, int Rank>
 class all_iterator
 {
 public:
+    // pos is relative to the offset of the view
     all_iterator(const AllType &all, cl::sycl::id<Rank> pos,
                     cl::sycl::range<Rank> range)
         : it_(pos, range), all_(all) {}
 
     bool operator==(const all_iterator &rhs)
     {
-        return detail::equals(get_id(), rhs.get_id());
+        return detail::equals(*it_, *rhs.it_);
     }
 
     bool operator!=(const all_iterator &rhs)
     {
-        return !detail::equals(get_id(), rhs.get_id());
+        return !detail::equals(*it_, *rhs.it_);
     }
 
     all_iterator &operator++()
@@ -147,21 +148,21 @@ public:
 
     [[nodiscard]] auto operator*() const { return all_[get_id()]; }
 
-    [[nodiscard]] cl::sycl::id<Rank> get_id() const { return *it_; }
+    [[nodiscard]] cl::sycl::id<Rank> get_id() const { return *it_ + all_.get_offset(); }
 
 private:
     iterator<Rank> it_;
     const AllType &all_;
 };
 
-template <typename T, int Rank>
-auto begin(const all<T, Rank> &all)
+template <typename Accessor, int Rank>
+auto begin(const basic_all<Accessor, Rank> &all)
 {
     return all_iterator{all, {}, all.get_range()};
 }
 
-template <typename T, int Rank>
-auto end(const all<T, Rank> &all)
+template <typename Accessor, int Rank>
+auto end(const basic_all<Accessor, Rank> &all)
 {
     return all_iterator{all, cl::sycl::id<Rank>{all.get_range()},
                         all.get_range()};
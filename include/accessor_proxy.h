@@ -11,6 +11,11 @@
 #include "iterator.h"
 #include "policy.h"
 #include "item_context.h"
+#include "transient.h"
+#include "tile.h"
+#include "work_group.h"
+#include "element_launch.h"
+#include "profiling.h"
 
 #include <type_traits>
 #include <cmath>
@@ -67,8 +72,8 @@ namespace celerity::algorithm::detail
 		}
 	};
 
-	template <typename T, int Rank, typename AccessorType>
-	class accessor_proxy<T, Rank, AccessorType, all<T, Rank>>
+	template <typename T, int Rank, typename AccessorType, typename ViewAccessor>
+	class accessor_proxy<T, Rank, AccessorType, basic_all<ViewAccessor, Rank>>
 		: public accessor_proxy_base<AccessorType>
 	{
 	public:
@@ -77,7 +82,7 @@ namespace celerity::algorithm::detail
 		explicit accessor_proxy(AccessorType acc, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
 			: base(acc), offset_(offset), range_(range) {}
 
-		all<T, Rank> operator[](const cl::sycl::item<Rank>) const
+		basic_all<ViewAccessor, Rank> operator[](const cl::sycl::item<Rank>) const
 		{
 			return {base::get_accessor(), offset_, range_};
 		}
@@ -87,9 +92,9 @@ namespace celerity::algorithm::detail
 		cl::sycl::range<Rank> range_;
 	};
 
-	template <typename T, int Rank, typename AccessorType, size_t Dim,
+	template <typename T, int Rank, typename AccessorType, typename ViewAccessor, size_t Dim,
 			  bool Transposed>
-	class accessor_proxy<T, Rank, AccessorType, slice<T, Dim, Transposed>>
+	class accessor_proxy<T, Rank, AccessorType, basic_slice<ViewAccessor, Dim, Transposed>>
 		: public accessor_proxy_base<AccessorType>
 	{
 	public:
@@ -100,7 +105,7 @@ namespace celerity::algorithm::detail
 		explicit accessor_proxy(AccessorType acc, cl::sycl::id<Rank>, cl::sycl::range<Rank> range)
 			: base(acc), range_(range) {}
 
-		slice<T, Dim, Transposed> operator[](const cl::sycl::item<Rank> item) const
+		basic_slice<ViewAccessor, Dim, Transposed> operator[](const cl::sycl::item<Rank> item) const
 		{
 			return {item, range_, base::get_accessor()};
 		}
@@ -109,8 +114,29 @@ namespace celerity::algorithm::detail
 		cl::sycl::range<Rank> range_;
 	};
 
+	template <typename T, int Rank, typename AccessorType, typename ViewAccessor, size_t... Extents>
+	class accessor_proxy<T, Rank, AccessorType, basic_chunk<ViewAccessor, Extents...>>
+		: public accessor_proxy_base<AccessorType>
+	{
+	public:
+		using base = accessor_proxy_base<AccessorType>;
+
+		static_assert(sizeof...(Extents) == Rank, "must specify extent for every dimension");
+
+		explicit accessor_proxy(AccessorType acc, cl::sycl::id<Rank>, cl::sycl::range<Rank>)
+			: base(acc)
+		{
+		}
+
+		basic_chunk<ViewAccessor, Extents...> operator[](const cl::sycl::item<Rank> item) const
+		{
+			return {item, base::get_accessor()};
+		}
+	};
+
+	// chunks of a transient input are read from the tile which the fused producer computed for the work item
 	template <typename T, int Rank, typename AccessorType, size_t... Extents>
-	class accessor_proxy<T, Rank, AccessorType, chunk<T, Extents...>>
+	class accessor_proxy<tile<T, Extents...>, Rank, AccessorType, chunk<T, Extents...>>
 		: public accessor_proxy_base<AccessorType>
 	{
 	public:
@@ -123,38 +149,214 @@ namespace celerity::algorithm::detail
 		{
 		}
 
-		chunk<T, Extents...> operator[](const cl::sycl::item<Rank> item) const
+		chunk<T, Extents...> operator[](item_shared_data<Rank, tile<T, Extents...>> in) const
+		{
+			const cl::sycl::item<Rank> item = in;
+			return {item, tile_accessor<T, Rank>{in.get(), item.get_id()}};
+		}
+	};
+
+	// slices of statically typed views are staged through a tile of local memory holding the slices of the work group,
+	// staged proxies are not indexed but loaded through load_view, as loading synchronizes the work group
+	template <typename T, int Rank, typename AccessorType, typename View>
+	class staged_accessor_proxy;
+
+	template <typename T, int Rank, typename AccessorType, typename ViewAccessor, size_t Dim>
+	class staged_accessor_proxy<T, Rank, AccessorType, basic_slice<ViewAccessor, Dim, false>>
+		: public accessor_proxy_base<AccessorType>
+	{
+	public:
+		using base = accessor_proxy_base<AccessorType>;
+		using view_type = basic_slice<ViewAccessor, Dim, false>;
+		using stage_type = typename view_type::stage_type;
+
+		static_assert(Dim >= 0 && Dim < Rank, "Dim out of bounds");
+
+		explicit staged_accessor_proxy(AccessorType acc, cl::sycl::range<Rank> range, celerity::handler &cgh)
+			: base(acc), range_(range), staged_(stage_type::fits(current_work_group_size<Rank>(), range)),
+			  tile_(stage_type::allocated_range(current_work_group_size<Rank>(), range), cgh) {}
+
+		// must be called by all work items of the group at the same point, see load_view
+		view_type load(item_shared_data<Rank, T> in) const
+		{
+			const cl::sycl::item<Rank> item = in;
+
+			if (!staged_ || in.get_group() == nullptr)
+			{
+				return {item, range_, base::get_accessor()};
+			}
+
+			stage_type stage{tile_, in.get_group()};
+			stage.load(base::get_accessor(), item.get_id(), range_);
+
+			return {item, range_, base::get_accessor(), stage};
+		}
+
+		view_type operator[](const cl::sycl::item<Rank> item) const
+		{
+			return {item, range_, base::get_accessor()};
+		}
+
+	private:
+		cl::sycl::range<Rank> range_;
+		bool staged_;
+		local_accessor<T, Rank> tile_;
+	};
+
+	// chunks of statically typed views are staged through a tile of local memory which covers the work group and the halo of the chunk
+	template <typename T, int Rank, typename AccessorType, typename ViewAccessor, size_t... Extents>
+	class staged_accessor_proxy<T, Rank, AccessorType, basic_chunk<ViewAccessor, Extents...>>
+		: public accessor_proxy_base<AccessorType>
+	{
+	public:
+		using base = accessor_proxy_base<AccessorType>;
+		using view_type = basic_chunk<ViewAccessor, Extents...>;
+		using stage_type = typename view_type::stage_type;
+
+		static_assert(sizeof...(Extents) == Rank, "must specify extent for every dimension");
+
+		explicit staged_accessor_proxy(AccessorType acc, cl::sycl::range<Rank> range, celerity::handler &cgh)
+			: base(acc), range_(range), tile_(stage_type::tile_range(current_work_group_size<Rank>()), cgh) {}
+
+		// must be called by all work items of the group at the same point, see load_view
+		view_type load(item_shared_data<Rank, T> in) const
+		{
+			const cl::sycl::item<Rank> item = in;
+
+			if (in.get_group() == nullptr)
+			{
+				return {item, base::get_accessor()};
+			}
+
+			stage_type stage{tile_, in.get_group()};
+			stage.load(base::get_accessor(), item.get_id(), range_);
+
+			return {item, base::get_accessor(), stage};
+		}
+
+		view_type operator[](const cl::sycl::item<Rank> item) const
 		{
 			return {item, base::get_accessor()};
 		}
+
+	private:
+		cl::sycl::range<Rank> range_;
+		local_accessor<T, Rank> tile_;
 	};
 
+	template <typename Proxy>
+	struct is_staged_accessor_proxy : std::false_type
+	{
+	};
+
+	template <typename T, int Rank, typename AccessorType, typename View>
+	struct is_staged_accessor_proxy<staged_accessor_proxy<T, Rank, AccessorType, View>> : std::true_type
+	{
+	};
+
+	// the view of the calling work item, staged views are loaded into local memory by the whole work group here,
+	// so kernels of algorithms call it for every work item before invoking the function of the user, never inside of it
+	// or in a branch, and the function of the user can return early or read its view in any order
+	template <typename Proxy, typename In>
+	decltype(auto) load_view(const Proxy &acc, In in)
+	{
+		if constexpr (is_staged_accessor_proxy<Proxy>::value)
+		{
+			return acc.load(in);
+		}
+		else
+		{
+			return acc[in];
+		}
+	}
+
+	template <typename ExecutionPolicy, typename AccessorType>
+	constexpr bool stages_through_local_memory()
+	{
+		if constexpr (traits::launches_work_groups_v<ExecutionPolicy> && traits::is_slice_v<AccessorType>)
+		{
+			return !std::is_same_v<typename AccessorType::stage_type, no_slice_stage>;
+		}
+		else if constexpr (traits::launches_work_groups_v<ExecutionPolicy> && traits::is_chunk_v<AccessorType>)
+		{
+			return !std::is_same_v<typename AccessorType::stage_type, no_chunk_stage>;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// creates an accessor requesting the elements mapper maps the elements the work items of the current launch evaluate to
+	template <int Rank, cl::sycl::access::mode Mode, cl::sycl::access::target Target, typename T, typename RangeMapper>
+	auto get_element_access(celerity::handler &cgh, celerity::buffer<T, Rank> buffer, RangeMapper mapper)
+	{
+#ifdef CELERITY_STD_ENABLE_PROFILING
+		record_access<Mode>(buffer, mapper);
+#endif
+
+		if (has_element_launch<Rank>())
+		{
+			return buffer.template get_access<Mode, Target>(cgh, map_to_elements<Rank>(mapper));
+		}
+
+		return buffer.template get_access<Mode, Target>(cgh, mapper);
+	}
+
+	// creates an accessor requesting the elements the work items of the current launch evaluate,
+	// widened by the halo of the tiles a fused consumer recomputes them for
+	template <int Rank, cl::sycl::access::mode Mode, cl::sycl::access::target Target, typename T, typename RangeMapper>
+	auto get_launch_access(celerity::handler &cgh, celerity::buffer<T, Rank> buffer, RangeMapper mapper)
+	{
+		if (has_tile_halo<Rank>())
+		{
+			return get_element_access<Rank, Mode, Target>(cgh, buffer, tiled<Rank>(mapper));
+		}
+
+		return get_element_access<Rank, Mode, Target>(cgh, buffer, mapper);
+	}
+
 	template <typename ExecutionPolicy, cl::sycl::access::mode Mode, typename AccessorType, template <typename, int> typename Iterator, typename T, int Rank>
 	auto create_accessor(celerity::handler &cgh, Iterator<T, Rank> beg, Iterator<T, Rank> end)
 	{
 		// TODO: move accessor creation into proxy
 		if constexpr (traits::policy_traits<ExecutionPolicy>::is_distributed)
 		{
+			constexpr auto target = traits::distributed_accessor_target_v<ExecutionPolicy>;
+
 			if constexpr (traits::get_accessor_type_<AccessorType>() != algorithm::detail::access_type::all)
 			{
-				return beg.get_buffer().template get_access<Mode>(cgh, traits::accessor_traits<Rank, AccessorType>::range_mapper());
+				return get_launch_access<Rank, Mode, target>(cgh, beg.get_buffer(), traits::accessor_traits<Rank, AccessorType>::range_mapper());
 			}
 			else
 			{
+				const auto access = [&](auto mapper) {
+#ifdef CELERITY_STD_ENABLE_PROFILING
+					if constexpr (!traits::is_transient_v<Iterator<T, Rank>>)
+					{
+						record_access<Mode>(beg.get_buffer(), mapper);
+					}
+#endif
+
+					return beg.get_buffer().template get_access<Mode, target>(cgh, mapper);
+				};
+
 				if (is_subrange(beg, end))
 				{
-					return beg.get_buffer().template get_access<Mode>(cgh, celerity::access::fixed<Rank>({*beg, distance(beg, end)}));
+					return access(celerity::access::fixed<Rank>({*beg, distance(beg, end)}));
 				}
 				else
 				{
-					return beg.get_buffer().template get_access<Mode>(cgh, traits::accessor_traits<Rank, AccessorType>::range_mapper());
+					return access(traits::accessor_traits<Rank, AccessorType>::range_mapper());
 				}
 			}
 		}
 		else
 		{
 			static_assert(traits::is_all_v<AccessorType>, "for master node tasks only all<> is supported");
-			return beg.get_buffer().template get_access<Mode, cl::sycl::access::target::host_buffer>(cgh, traits::accessor_traits<Rank, AccessorType>::range_mapper());
+
+			// only the range the task reads is transferred to the master
+			return beg.get_buffer().template get_access<Mode, cl::sycl::access::target::host_buffer>(cgh, celerity::access::fixed<Rank>({*beg, distance(beg, end)}));
 		}
 	}
 
@@ -162,7 +364,24 @@ namespace celerity::algorithm::detail
 	auto get_access(celerity::handler &cgh, Iterator<T, Rank> beg, Iterator<T, Rank> end)
 	{
 		const auto acc = create_accessor<ExecutionPolicy, Mode, AccessorType>(cgh, beg, end);
-		return accessor_proxy<T, Rank, decltype(acc), AccessorType>{acc, *beg, beg.get_buffer().get_range()};
+
+		if constexpr (stages_through_local_memory<ExecutionPolicy, AccessorType>())
+		{
+			return staged_accessor_proxy<T, Rank, decltype(acc), AccessorType>{acc, beg.get_buffer().get_range(), cgh};
+		}
+		else if constexpr (traits::is_all_v<AccessorType> && !traits::policy_traits<ExecutionPolicy>::is_distributed)
+		{
+			// master tasks only read [beg, end), so their all<> views span this range
+			return accessor_proxy<T, Rank, decltype(acc), AccessorType>{acc, *beg, distance(beg, end)};
+		}
+		else if constexpr (traits::is_all_v<AccessorType>)
+		{
+			return accessor_proxy<T, Rank, decltype(acc), AccessorType>{acc, {}, beg.get_buffer().get_range()};
+		}
+		else
+		{
+			return accessor_proxy<T, Rank, decltype(acc), AccessorType>{acc, *beg, beg.get_buffer().get_range()};
+		}
 	}
 
 } // namespace celerity::algorithm::detail
@@ -17,8 +17,8 @@ struct accessor_traits<Rank, detail::one_to_one>
     }
 };
 
-template <int Rank, typename T, size_t Dim, size_t IndexDim>
-struct accessor_traits<Rank, slice<T, Dim, IndexDim>>
+template <int Rank, typename Accessor, size_t Dim, bool Transposed>
+struct accessor_traits<Rank, basic_slice<Accessor, Dim, Transposed>>
 {
     static auto range_mapper()
     {
@@ -26,8 +26,8 @@ struct accessor_traits<Rank, slice<T, Dim, IndexDim>>
     }
 };
 
-template <int Rank, typename T, size_t... Extents>
-struct accessor_traits<Rank, chunk<T, Extents...>>
+template <int Rank, typename Accessor, size_t... Extents>
+struct accessor_traits<Rank, basic_chunk<Accessor, Extents...>>
 {
     static auto range_mapper()
     {
@@ -35,8 +35,8 @@ struct accessor_traits<Rank, chunk<T, Extents...>>
     }
 };
 
-template <int Rank, typename T>
-struct accessor_traits<Rank, all<T, Rank>>
+template <int Rank, typename Accessor>
+struct accessor_traits<Rank, basic_all<Accessor, Rank>>
 {
     static auto range_mapper()
     {
@@ -49,8 +49,8 @@ struct is_slice : std::false_type
 {
 };
 
-template <typename T, size_t Dim, bool Transposed>
-struct is_slice<slice<T, Dim, Transposed>> : std::true_type
+template <typename Accessor, size_t Dim, bool Transposed>
+struct is_slice<basic_slice<Accessor, Dim, Transposed>> : std::true_type
 {
 };
 
@@ -62,8 +62,8 @@ struct is_chunk : std::false_type
 {
 };
 
-template <typename T, size_t... Extents>
-struct is_chunk<chunk<T, Extents...>> : public std::true_type
+template <typename Accessor, size_t... Extents>
+struct is_chunk<basic_chunk<Accessor, Extents...>> : public std::true_type
 {
 };
 
@@ -80,6 +80,11 @@ struct is_item<cl::sycl::item<Rank>> : public std::true_type
 {
 };
 
+template <int Rank>
+struct is_item<group_item<Rank>> : public std::true_type
+{
+};
+
 template <typename T>
 inline constexpr auto is_item_v = is_item<T>::value;
 
@@ -88,14 +93,18 @@ struct is_all : std::false_type
 {
 };
 
-template <typename T, int Rank>
-struct is_all<all<T, Rank>> : std::true_type
+template <typename Accessor, int Rank>
+struct is_all<basic_all<Accessor, Rank>> : std::true_type
 {
 };
 
 template <typename T>
 inline constexpr auto is_all_v = is_all<T>::value;
 
+// views reading through any_accessor can be backed by any accessor, e.g. a tile of a fused producer
+template <typename T>
+inline constexpr bool is_type_erased_view_v = is_any_accessor_v<typename T::accessor_type>;
+
 } // namespace celerity::algorithm::traits
 
 #endif // ACCESSOR_TRAITS_H
\ No newline at end of file
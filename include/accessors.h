@@ -5,6 +5,7 @@
 
 #include "any_accessor.h"
 #include "variant_item.h"
+#include "work_group.h"
 
 namespace celerity::algorithm
 {
@@ -21,31 +22,101 @@ namespace celerity::algorithm
 		{
 		};
 
+		// reads an element either through the type erased any_accessor or directly from a concrete accessor
+		template <typename Accessor, int Rank>
+		auto read_element(const Accessor &acc, cl::sycl::id<Rank> id) -> traits::accessor_value_type_t<Accessor>
+		{
+			if constexpr (traits::is_any_accessor_v<Accessor>)
+			{
+				return acc.get(id);
+			}
+			else
+			{
+				return acc[id];
+			}
+		}
+
+		// the rank of a type erased slice is only known at runtime
+		template <typename Accessor, typename = void>
+		struct slice_item
+		{
+			using type = cl::sycl::item<traits::accessor_rank_v<Accessor>>;
+		};
+
+		template <typename T, typename Storage>
+		struct slice_item<any_accessor<T, Storage>>
+		{
+			using type = variant_item<2, 3>;
+		};
+
+		template <typename Accessor>
+		using slice_item_t = typename slice_item<Accessor>::type;
+
+		template <int... Ranks, typename F>
+		decltype(auto) apply_item(const variant_item<Ranks...> &item, F f)
+		{
+			return item.apply(f);
+		}
+
+		template <int Rank, typename F>
+		decltype(auto) apply_item(const cl::sycl::item<Rank> &item, F f)
+		{
+			return f(item);
+		}
+
+		template <typename Accessor, typename AccessorType>
+		constexpr void assert_view_accessor()
+		{
+			static_assert(traits::is_any_accessor_v<Accessor> || std::is_same_v<Accessor, AccessorType>,
+						  "a statically typed view can only be created from the accessor it is typed on");
+		}
+
 	} // namespace detail
 
-	template <typename T, size_t Dim, bool Transpose = false>
-	class slice
+	// slices of statically typed views are read from local memory when the task is launched in work groups
+	// and the slices of the group fit into it, they are staged before the kernel runs, so work items can read
+	// any part of their slice in any order
+	template <typename Accessor, size_t Dim, bool Transpose = false>
+	class basic_slice
 	{
 	public:
-		using value_type = T;
+		using accessor_type = Accessor;
+		using value_type = traits::accessor_value_type_t<Accessor>;
+		using stage_type = detail::slice_stage_t<Accessor, Dim, Transpose>;
 
-		template <int Rank, cl::sycl::access::mode Mode, cl::sycl::access::target Target>
-		slice(const cl::sycl::item<Rank> item, const cl::sycl::range<Rank> range, celerity::algorithm::detail::device_accessor<T, Rank, Mode, Target> acc)
+		template <int Rank, typename AccessorType>
+		basic_slice(const cl::sycl::item<Rank> item, const cl::sycl::range<Rank> range, const AccessorType &acc)
 			: idx_(static_cast<int>(item.get_id()[Dim])), range_(range[Dim]), item_(item), accessor_(acc)
 		{
+			detail::assert_view_accessor<Accessor, AccessorType>();
+		}
+
+		template <int Rank, typename AccessorType>
+		basic_slice(const cl::sycl::item<Rank> item, const cl::sycl::range<Rank> range, const AccessorType &acc, const stage_type &stage)
+			: idx_(static_cast<int>(item.get_id()[Dim])), range_(range[Dim]), item_(item), accessor_(acc), stage_(stage)
+		{
+			detail::assert_view_accessor<Accessor, AccessorType>();
 		}
 
 		int index() const { return idx_; }
 		int get_range() const { return range_; }
 
-		T operator*() const
+		value_type operator*() const
 		{
 			return this->operator[](idx_);
 		}
 
-		T operator[](int pos) const
+		value_type operator[](int pos) const
 		{
-			return item_.apply([pos, this](const auto &item) {
+			if constexpr (!std::is_same_v<stage_type, detail::no_slice_stage>)
+			{
+				if (stage_.is_staged())
+				{
+					return stage_.get(pos);
+				}
+			}
+
+			return detail::apply_item(item_, [pos, this](const auto &item) {
 				using id_type = std::decay_t<decltype(item.get_id())>;
 
 				if constexpr (Transpose && std::is_same_v<id_type, cl::sycl::id<2>>)
@@ -54,63 +125,79 @@ namespace celerity::algorithm
 					id[1 - Dim] = id[Dim];
 					id[Dim] = pos;
 
-					return accessor_.template get(id);
+					return detail::read_element(accessor_, id);
 				}
 				else if constexpr (Transpose)
 				{
 					// TODO: unresolved external
 					// assert(false && "Only slices of 2-dimensional ranges can be transposed");
-					return T{};
+					return value_type{};
 				}
 				else
 				{
 					auto id = item.get_id();
 					id[Dim] = pos;
-					return accessor_.template get(id);
+					return detail::read_element(accessor_, id);
 				}
 			});
 		}
 
-		slice(const slice<T, Dim> &) = delete;
-		slice(slice<T, Dim> &&) = delete;
-		slice<T, Dim> &operator=(const slice<T, Dim> &) = delete;
-		slice<T, Dim> &operator=(slice<T, Dim> &&) = delete;
+		basic_slice(const basic_slice &) = delete;
+		basic_slice(basic_slice &&) = delete;
+		basic_slice &operator=(const basic_slice &) = delete;
+		basic_slice &operator=(basic_slice &&) = delete;
 
 		template <typename V>
-		slice<T, Dim> &operator=(const V &) = delete;
+		basic_slice &operator=(const V &) = delete;
 
 	private:
 		const int idx_;
 		const int range_;
-		const variant_item<2, 3> item_;
-		const detail::any_accessor<T> accessor_;
+		const detail::slice_item_t<Accessor> item_;
+		const Accessor accessor_;
+		const stage_type stage_;
 	};
 
+	template <typename T, size_t Dim, bool Transpose = false>
+	using slice = basic_slice<detail::any_accessor<T>, Dim, Transpose>;
+
 	template <typename T, size_t Dim>
 	using t_slice = slice<T, Dim, true>;
 
-	template <typename T, size_t... Extents>
-	class chunk
+	// chunks of statically typed views read the tile of their work group plus the halo from local memory
+	// when the task is launched in work groups, the tile is loaded before the kernel runs
+	template <typename Accessor, size_t... Extents>
+	class basic_chunk
 	{
 	public:
-		using value_type = T;
+		using accessor_type = Accessor;
+		using value_type = traits::accessor_value_type_t<Accessor>;
+		using stage_type = detail::chunk_stage_t<Accessor, Extents...>;
 
 		static constexpr auto rank = sizeof...(Extents);
 
 		template <typename AccessorType>
-		chunk(cl::sycl::item<rank> item, AccessorType acc)
+		basic_chunk(cl::sycl::item<rank> item, const AccessorType &acc)
 			: item_(item), accessor_(acc)
 		{
+			detail::assert_view_accessor<Accessor, AccessorType>();
+		}
+
+		template <typename AccessorType>
+		basic_chunk(cl::sycl::item<rank> item, const AccessorType &acc, const stage_type &stage)
+			: item_(item), accessor_(acc), stage_(stage)
+		{
+			detail::assert_view_accessor<Accessor, AccessorType>();
 		}
 
 		auto item() const { return item_; }
 
-		T operator*() const
+		value_type operator*() const
 		{
 			return this->operator[]({});
 		}
 
-		T operator[](cl::sycl::rel_id<rank> rel_id) const
+		value_type operator[](cl::sycl::rel_id<rank> rel_id) const
 		{
 			auto id = item_.get_id();
 			
@@ -119,20 +206,28 @@ namespace celerity::algorithm
 				id[i] = static_cast<size_t>(static_cast<long>(id[i]) + rel_id[i]);
 			}
 
-			return accessor_.template get(id);
+			return get(id);
 		}
 
-		chunk(const chunk<T, Extents...> &) = delete;
-		chunk(chunk<T, Extents...> &&) = delete;
-		chunk<T, Extents...> &operator=(const chunk<T, Extents...> &) = delete;
-		chunk<T, Extents...> &operator=(chunk<T, Extents...> &&) = delete;
+		basic_chunk(const basic_chunk &) = delete;
+		basic_chunk(basic_chunk &&) = delete;
+		basic_chunk &operator=(const basic_chunk &) = delete;
+		basic_chunk &operator=(basic_chunk &&) = delete;
 
 		template <typename V>
-		chunk<T, Extents...> &operator=(const V &) = delete;
+		basic_chunk &operator=(const V &) = delete;
 
-		T get(cl::sycl::id<rank> abs_id) const
+		value_type get(cl::sycl::id<rank> abs_id) const
 		{
-			return accessor_.template get(abs_id);
+			if constexpr (!std::is_same_v<stage_type, detail::no_chunk_stage>)
+			{
+				if (stage_.is_staged())
+				{
+					return stage_.get(accessor_, abs_id);
+				}
+			}
+
+			return detail::read_element(accessor_, abs_id);
 		}
 
 		bool is_on_boundary() const
@@ -174,7 +269,8 @@ namespace celerity::algorithm
 
 	private:
 		const cl::sycl::item<rank> item_;
-		const detail::any_accessor<T> accessor_;
+		const Accessor accessor_;
+		const stage_type stage_;
 
 		template <size_t... Is>
 		bool dispatch_is_on_boundary(cl::sycl::range<rank> range, std::index_sequence<Is...>) const
@@ -186,41 +282,49 @@ namespace celerity::algorithm
 		}
 	};
 
-	template <typename T, int Rank>
-	class all
+	template <typename T, size_t... Extents>
+	using chunk = basic_chunk<detail::any_accessor<T>, Extents...>;
+
+	template <typename Accessor, int Rank>
+	class basic_all
 	{
 	public:
-		using value_type = T;
+		using accessor_type = Accessor;
+		using value_type = traits::accessor_value_type_t<Accessor>;
 
 		template <typename AccessorType>
-		all(AccessorType acc, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+		basic_all(const AccessorType &acc, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
 			: accessor_(acc), offset_(offset), range_(range)
 		{
+			detail::assert_view_accessor<Accessor, AccessorType>();
 		}
 
-		T operator[](cl::sycl::id<Rank> id) const
+		value_type operator[](cl::sycl::id<Rank> id) const
 		{
-			return accessor_.template get(id);
+			return detail::read_element(accessor_, id);
 		}
 
-		all(const all<T, Rank> &) = delete;
-		all(all<T, Rank> &&) = delete;
-		all<T, Rank> &operator=(const all<T, Rank> &) = delete;
-		all<T, Rank> &operator=(all<T, Rank> &&) = delete;
+		basic_all(const basic_all &) = delete;
+		basic_all(basic_all &&) = delete;
+		basic_all &operator=(const basic_all &) = delete;
+		basic_all &operator=(basic_all &&) = delete;
 
 		template <typename V>
-		all<T, Rank> &operator=(const V &) = delete;
+		basic_all &operator=(const V &) = delete;
 
 		auto get_range() const -> cl::sycl::range<Rank> { return range_; }
 		auto get_offset() const -> cl::sycl::id<Rank> { return offset_; }
 
 	private:
 		const detail::sycl_marker _ = {};
-		const detail::any_accessor<T> accessor_;
+		const Accessor accessor_;
 		const cl::sycl::id<Rank> offset_;
 		const cl::sycl::range<Rank> range_;
 	};
 
+	template <typename T, int Rank>
+	using all = basic_all<detail::any_accessor<T>, Rank>;
+
 	namespace aliases
 	{
 
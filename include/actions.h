@@ -7,6 +7,8 @@
 #include <mpi.h>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace celerity::algorithm
 {
@@ -16,9 +18,7 @@ inline void sync()
 	MPI_Barrier(MPI_COMM_WORLD);
 }
 
-// TODO: rename this so it does not seem like it submits a with_master_access task...
-template <typename F, typename... Args>
-auto on_master(F &&f, Args &&... args)
+inline bool is_master_node()
 {
 	static thread_local const bool is_master = []() {
 		if (int world_rank; MPI_Comm_rank(MPI_COMM_WORLD, &world_rank) == MPI_SUCCESS)
@@ -29,12 +29,59 @@ auto on_master(F &&f, Args &&... args)
 		throw std::logic_error("MPI not initialized");
 	}();
 
-	if (!is_master)
+	return is_master;
+}
+
+// TODO: rename this so it does not seem like it submits a with_master_access task...
+template <typename F, typename... Args>
+auto on_master(F &&f, Args &&... args)
+{
+	if (!is_master_node())
 		return;
 
 	std::invoke(f, std::forward<Args>(args)...);
 }
 
+// gathers a value from every node of comm on every node, the values are ordered by the ranks of the nodes
+template <typename T>
+std::vector<T> all_gather(MPI_Comm comm, const T &value)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be gathered");
+
+	int size = 0;
+	MPI_Comm_size(comm, &size);
+
+	std::vector<T> values(size);
+
+	if (MPI_Allgather(&value, sizeof(T), MPI_BYTE, values.data(), sizeof(T), MPI_BYTE, comm) != MPI_SUCCESS)
+	{
+		throw std::runtime_error("MPI allgather failed");
+	}
+
+	return values;
+}
+
+// gathers the values of every node of comm on every node, all nodes have to pass the same number of values,
+// the values of a node follow those of the nodes of lower rank
+template <typename T>
+std::vector<T> all_gather(MPI_Comm comm, const std::vector<T> &values)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be gathered");
+
+	int size = 0;
+	MPI_Comm_size(comm, &size);
+
+	std::vector<T> gathered(size * values.size());
+	const auto bytes = static_cast<int>(values.size() * sizeof(T));
+
+	if (MPI_Allgather(values.data(), bytes, MPI_BYTE, gathered.data(), bytes, MPI_BYTE, comm) != MPI_SUCCESS)
+	{
+		throw std::runtime_error("MPI allgather failed");
+	}
+
+	return gathered;
+}
+
 } // namespace celerity::algorithm
 
 #endif
@@ -7,7 +7,15 @@
 #include "algorithms/accumulate.h"
 #include "algorithms/for_each.h"
 #include "algorithms/copy.h"
+#include "algorithms/scan.h"
+#include "algorithms/copy_if.h"
+#include "algorithms/sort.h"
+#include "algorithms/histogram.h"
+#include "algorithms/reduce_dim.h"
+#include "algorithms/file.h"
 
 #include "master_task.h"
+#include "time_blocking.h"
+#include "snapshot.h"
 
 #endif
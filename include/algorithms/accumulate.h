@@ -7,38 +7,317 @@
 #include "../policy.h"
 #include "../sequencing.h"
 #include "../require.h"
+#include "../actions.h"
 
 namespace celerity::algorithm
 {
 
 namespace detail
 {
-template <typename ExecutionPolicy, typename BinaryOp, typename T, int Rank,
-		  require<traits::get_accessor_type<BinaryOp, 1>() == access_type::one_to_one> = yes>
-auto accumulate_impl(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, T init, const BinaryOp &op)
+
+// upper bound for the number of partial results of the first reduction stage
+inline constexpr size_t max_reduction_partials = 1024;
+
+template <int Rank>
+size_t reduction_block_size(cl::sycl::range<Rank> range)
+{
+	return std::max<size_t>(1, (range[0] + max_reduction_partials - 1) / max_reduction_partials);
+}
+
+template <int Rank>
+cl::sycl::range<Rank> reduction_partials_range(cl::sycl::range<Rank> range, size_t block_size)
+{
+	auto partials_range = range;
+
+	partials_range[0] = (range[0] + block_size - 1) / block_size;
+
+	for (int i = 1; i < Rank; ++i)
+	{
+		partials_range[i] = 1;
+	}
+
+	return partials_range;
+}
+
+// maps a chunk of partial results to the block of rows (first dimension) of the input they are folded from,
+// so every node only reads the part of the input it owns
+template <int Rank>
+struct reduction_block_mapper
+{
+	cl::sycl::id<Rank> offset;
+	cl::sycl::range<Rank> range;
+	size_t block_size;
+
+	celerity::subrange<Rank> operator()(celerity::chunk<Rank> chnk) const
+	{
+		auto block_offset = offset;
+		auto block_range = range;
+
+		const auto first_row = std::min(chnk.offset[0] * block_size, range[0]);
+
+		block_offset[0] += first_row;
+		block_range[0] = std::min(chnk.range[0] * block_size, range[0] - first_row);
+
+		return {block_offset, block_range};
+	}
+};
+
+// every partial result is folded from a block of block_size rows (first dimension) of the input
+template <int Rank>
+cl::sycl::range<Rank> reduction_block_factor(cl::sycl::range<Rank> range, size_t block_size)
+{
+	auto factor = range;
+	factor[0] = block_size;
+
+	return factor;
+}
+
+// reads the elements to be folded, producing stages of a pipeline are fused into this task
+template <typename ExecutionPolicy, template <typename, int> typename InIterator, typename T, int Rank>
+auto accumulate_elements_impl(InIterator<T, Rank> beg, InIterator<T, Rank> end)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using policy_type = strip_queue_t<ExecutionPolicy>;
+
+	return [=](celerity::handler &cgh) {
+		auto in_acc = get_access<policy_type, mode::read, one_to_one>(cgh, beg, end);
+
+		return [=](item_context<Rank, T(T)> &ctx) {
+			ctx.get_out().get() = in_acc[ctx.get_in()];
+		};
+	};
+}
+
+// partial result of a reduction, work items past the end of the input and empty parts have no valid partial result
+template <typename T>
+struct reduction_partial
+{
+	T value;
+	bool valid;
+};
+
+template <typename T, typename BinaryOp>
+reduction_partial<T> combine_partials(const reduction_partial<T> &lhs, const reduction_partial<T> &rhs, const BinaryOp &op)
+{
+	if (!lhs.valid)
+	{
+		return rhs;
+	}
+
+	if (!rhs.valid)
+	{
+		return lhs;
+	}
+
+	return {op(lhs.value, rhs.value), true};
+}
+
+// upper bound for the number of work items of the work groups of a reduction
+inline constexpr size_t max_reduction_work_group_size = 256;
+
+// work groups of a reduction hold contiguous elements in row-major order, whole rows (last dimension) if the rows
+// are short and a part of one row otherwise, so the partial results of the groups are combined in the order of the input
+template <int Rank>
+cl::sycl::range<Rank> reduction_work_group_size(cl::sycl::range<Rank> range)
+{
+	cl::sycl::range<Rank> local_range{};
+
+	for (auto i = 0; i < Rank; ++i)
+	{
+		local_range[i] = 1;
+	}
+
+	local_range[Rank - 1] = std::min(range[Rank - 1], max_reduction_work_group_size);
+
+	if constexpr (Rank > 1)
+	{
+		if (range[Rank - 1] <= max_reduction_work_group_size)
+		{
+			local_range[Rank - 2] = std::min(range[Rank - 2], max_reduction_work_group_size / range[Rank - 1]);
+		}
+	}
+
+	return local_range;
+}
+
+// every work group folds the elements of its work items in local memory in a tree of log2(group size) steps,
+// the first work item of the group writes the partial result of the group
+template <typename ExecutionPolicy, typename ElementTask, typename BinaryOp, typename InputIterator, typename T, int Rank>
+auto reduce_groups_impl(ElementTask element_task, InputIterator beg, InputIterator end, buffer<reduction_partial<T>, Rank> partials, const BinaryOp &op)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using element_kernel_type = std::invoke_result_t<decltype(element_task.get_sequence()), handler &>;
+	using element_context_type = std::decay_t<arg_type_t<element_kernel_type, 0>>;
+
+	const auto element_sequence = element_task.get_sequence();
+	const auto offset = *beg;
+	const auto range = distance(beg, end);
+
+	return [=](celerity::handler &cgh) {
+		const auto local_range = current_work_group_size<Rank>();
+		const auto kernels = sequence(std::invoke(element_sequence, cgh));
+
+		auto partials_acc = partials.template get_access<mode::discard_write>(cgh, work_group_mapper<Rank>{offset, local_range});
+		local_accessor<reduction_partial<T>, 1> scratch{cl::sycl::range<1>{count(local_range)}, cgh};
+
+		return [=](item_context<Rank, T()> &ctx) {
+			const auto group = ctx.get_group();
+			const auto id = ctx.get_item().get_id();
+			const auto local_id = group->get_local_linear_id();
+			const auto n = count(local_range);
+
+			auto inside = true;
+
+			for (auto i = 0; i < Rank; ++i)
+			{
+				inside = inside && id[i] < offset[i] + range[i];
+			}
+
+			reduction_partial<T> partial{};
+
+			// the element kernels run outside of the group, only the reduction itself synchronizes the group
+			if (inside)
+			{
+				element_context_type element_ctx{cl::sycl::detail::make_item(id, range, offset)};
+				kernels(element_ctx);
+
+				partial = {element_ctx.get_out().get(), true};
+			}
+
+			scratch[cl::sycl::id<1>{local_id}] = partial;
+
+			// in every step the work items at multiples of 2 * stride fold the partial result stride items to their right into their own,
+			// neighbouring partial results are combined in order, so op only has to be associative
+			for (size_t stride = 1; stride < n; stride *= 2)
+			{
+				group->barrier();
+
+				if (local_id % (2 * stride) == 0 && local_id + stride < n)
+				{
+					scratch[cl::sycl::id<1>{local_id}] = combine_partials(scratch[cl::sycl::id<1>{local_id}], scratch[cl::sycl::id<1>{local_id + stride}], op);
+				}
+			}
+
+			if (local_id == 0)
+			{
+				partials_acc[group->get_group_id()] = scratch[cl::sycl::id<1>{0}];
+			}
+		};
+	};
+}
+
+// every node folds the partial results of the work groups in its share of the rows, the nodes then gather the folds of all nodes
+// and combine them in node order, so every node computes the result itself instead of waiting for a broadcast from the master
+template <typename BinaryOp, typename T, int Rank>
+auto combine_partials_impl(buffer<reduction_partial<T>, Rank> partials, T init, const BinaryOp &op)
 {
-	/*using policy_type = strip_queue_t<ExecutionPolicy>;
+	using namespace cl::sycl::access;
 
-	static_assert(!policy_traits<ExecutionPolicy>::is_distributed, "can not be distributed");
-	static_assert(Rank == 1, "Only 1-dimenionsal buffers for now");
+	const auto range = partials.get_range();
 
 	return [=](celerity::handler &cgh) {
-		const auto in_acc = get_access<policy_type, cl::sycl::access::mode::read, one_to_one>(cgh, beg, end);
+		auto partials_acc = partials.template get_access<mode::read, target::host_buffer>(cgh, node_part_mapper<Rank>{range});
+
+		return [=](celerity::experimental::collective_partition part) {
+			const auto sr = node_part(range, part.get_subrange().offset[0], part.get_global_size()[0]);
 
-		auto sum = init;
+			reduction_partial<T> node_partial{};
+			cl::sycl::id<Rank> id{};
 
-		dispatch<policy_type>(cgh, beg, end, [&](auto item) {
-			sum = op(std::move(sum), in_acc[item]);
-		});
+			for (size_t i = 0, n = count(sr.range); i < n; ++i, id = next(id, sr.range))
+			{
+				node_partial = combine_partials(node_partial, partials_acc[sr.offset + id], op);
+			}
 
-		return sum;
-	};*/
+			auto sum = init;
+
+			for (const auto &p : all_gather(part.get_collective_mpi_comm(), node_partial))
+			{
+				if (p.valid)
+				{
+					sum = op(sum, p.value);
+				}
+			}
+
+			return sum;
+		};
+	};
+}
+
+// every work group folds its elements into a partial result on the node owning them
+template <typename T, typename ExecutionPolicy, typename ElementTask, typename BinaryOp, template <typename, int> typename InIterator, typename U, int Rank>
+auto reduce_groups(distr_queue q, ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, const BinaryOp &op)
+{
+	const auto range = distance(beg, end);
+	const auto local_range = reduction_work_group_size(range);
+
+	auto groups = padded_range(range, local_range);
+
+	for (auto i = 0; i < Rank; ++i)
+	{
+		groups[i] /= local_range[i];
+	}
+
+	buffer<reduction_partial<T>, Rank> partials{groups};
+
+	using reduce_policy = traits::internal_launch_t<ExecutionPolicy>;
+
+	const auto reduce = task<reduce_policy>(reduce_groups_impl<reduce_policy>(element_task, beg, end, partials, op));
+	reduce(q, beg, end, local_range);
+
+	return partials;
+}
+
+// the returned future receives the result on this node once the collective host task combining the partial results ran,
+// getting it does not communicate, so futures can be dropped or got in any order
+template <typename ExecutionPolicy, typename ElementTask, typename BinaryOp, template <typename, int> typename InIterator, typename U, typename T, int Rank>
+auto accumulate_async(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, T init, const BinaryOp &op)
+{
+	static_assert(traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed, "accumulate requires a distributed execution policy");
+
+	return [=](distr_queue q) {
+		if (count(distance(beg, end)) == 0)
+		{
+			std::promise<T> empty;
+			empty.set_value(init);
+			return empty.get_future();
+		}
+
+		// 1. every work group folds its elements into a partial result on the node owning them
+		auto partials = reduce_groups<T, ExecutionPolicy>(q, element_task, beg, end, op);
+
+		// 2. every node folds the partial results of its share, the nodes exchange and combine their folds
+		return submit_collective_with_future(q, combine_partials_impl(partials, init, op));
+	};
+}
+
+template <typename ExecutionPolicy, typename ElementTask, typename BinaryOp, template <typename, int> typename InIterator, typename U, typename T, int Rank>
+auto accumulate(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, T init, const BinaryOp &op)
+{
+	return [=](distr_queue q) {
+		return std::invoke(accumulate_async<ExecutionPolicy>(element_task, beg, end, init, op), q).get();
+	};
 }
 
 template <typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
-auto accumulate(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, T init, const BinaryOp &op)
+auto accumulate(buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, T init, const BinaryOp &op)
+{
+	const auto element_task = task<ExecutionPolicy>(accumulate_elements_impl<ExecutionPolicy>(beg, end));
+	return accumulate<ExecutionPolicy>(element_task, beg, end, init, op);
+}
+
+template <typename ExecutionPolicy, typename BinaryOp, typename T>
+auto accumulate(T init, const BinaryOp &op)
 {
-	return task<ExecutionPolicy>(accumulate_impl(p, beg, end, init, op));
+	using element_policy = traits::strip_queue_t<ExecutionPolicy>;
+
+	return package_reduce<T>(
+		[](auto beg, auto end) { return task<element_policy>(accumulate_elements_impl<element_policy>(beg, end)); },
+		[init, op](distr_queue q, auto element_task, auto beg, auto end) { return std::invoke(accumulate<ExecutionPolicy>(element_task, beg, end, init, op), q); });
 }
 
 } // namespace detail
@@ -46,7 +325,28 @@ auto accumulate(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator
 template <typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
 auto accumulate(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, T init, const BinaryOp &op)
 {
-	return std::invoke(detail::accumulate(p, beg, end, init, op), p.q);
+	return std::invoke(detail::accumulate<ExecutionPolicy>(beg, end, init, op), p.q);
+}
+
+// returns a std::future<T> right after submitting the reduction, see detail::accumulate_async
+template <typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
+auto accumulate_async(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, T init, const BinaryOp &op)
+{
+	const auto element_task = detail::task<ExecutionPolicy>(detail::accumulate_elements_impl<ExecutionPolicy>(beg, end));
+	return std::invoke(detail::accumulate_async<ExecutionPolicy>(element_task, beg, end, init, op), p.q);
+}
+
+template <typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
+auto accumulate_async(ExecutionPolicy p, buffer<T, Rank> in, T init, const BinaryOp &op)
+{
+	return accumulate_async(p, begin(in), end(in), init, op);
+}
+
+template <typename KernelName, typename T, typename BinaryOp>
+auto accumulate(T init, const BinaryOp &op)
+{
+	using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+	return detail::accumulate<execution_policy>(init, op);
 }
 
 template <typename KernelName, typename BinaryOp, typename T, int Rank>
@@ -6,11 +6,66 @@
 #include "../accessor_proxy.h"
 #include "../policy.h"
 #include "../sequencing.h"
+#include "../require.h"
+#include "../host_threads.h"
+#include "../iterator_transform.h"
+
+#include <memory>
+#include <vector>
 
 namespace celerity::algorithm
 {
+
+// a block of a buffer on the master which is read straight from the accessor of the master task,
+// ids are relative to the offset of the block
+template <typename T, int Rank>
+class host_block
+{
+public:
+	using accessor_type = detail::host_accessor<T, Rank, cl::sycl::access::mode::read>;
+
+	host_block(const accessor_type &acc, celerity::subrange<Rank> block)
+		: acc_(acc), block_(block) {}
+
+	celerity::subrange<Rank> get_subrange() const { return block_; }
+	size_t size() const { return block_.range.size(); }
+
+	T operator[](cl::sycl::id<Rank> id) const { return acc_[block_.offset + id]; }
+
+	// writes the elements of the block in row-major order to dst
+	template <typename OutputIterator>
+	OutputIterator copy_to(OutputIterator dst) const
+	{
+		cl::sycl::id<Rank> id{};
+
+		for (size_t i = 0, n = size(); i < n; ++i, ++dst, id = next(id, block_.range))
+		{
+			*dst = acc_[block_.offset + id];
+		}
+
+		return dst;
+	}
+
+private:
+	accessor_type acc_;
+	celerity::subrange<Rank> block_;
+};
+
 namespace detail
 {
+// writes the elements [first, last) of [offset, offset + range) in row-major order to dst, every element is read through
+// the accessor, so neither the offset of the range nor the allocation backing the buffer on the master matter
+template <typename ValueType, typename Accessor, typename OutputIterator, int Rank>
+void copy_elements(const Accessor &acc, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range, size_t first, size_t last, OutputIterator dst)
+{
+	auto id = row_major_id(first, range);
+
+	for (auto i = first; i < last; ++i, ++dst, id = next(id, range))
+	{
+		*dst = static_cast<ValueType>(acc[offset + id]);
+	}
+}
+
 template <typename ExecutionPolicy, typename IteratorType, typename T, int Rank>
 auto copy_impl(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, IteratorType out)
 {
@@ -25,31 +80,180 @@ auto copy_impl(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<
 	return [=](celerity::handler &cgh) {
 		auto in_acc = get_access<policy_type, cl::sycl::access::mode::read, all<T, Rank>>(cgh, beg, end);
 
-		if constexpr (traits::is_contiguous_iterator<IteratorType>() &&
-					  sizeof(T) == sizeof(typename std::iterator_traits<IteratorType>::value_type))
+		using value_type = typename std::iterator_traits<IteratorType>::value_type;
+		using iterator_category = typename std::iterator_traits<IteratorType>::iterator_category;
+
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, iterator_category>)
 		{
-			return [=]() { memcpy(out, in_acc.get_accessor().get_pointer(), detail::distance(beg, end).size() * sizeof(T)); };
+			return [=]() {
+				const auto acc = in_acc.get_accessor();
+				const auto offset = *beg;
+				const auto range = detail::distance(beg, end);
+
+				// only a whole buffer is known to lie contiguously behind the pointer of the accessor
+				if constexpr (traits::is_contiguous_iterator<IteratorType>() &&
+							  std::is_same_v<std::remove_cv_t<value_type>, std::remove_cv_t<T>>)
+				{
+					if (!is_subrange(beg, end))
+					{
+						memcpy(out, acc.get_pointer(), range.size() * sizeof(T));
+						return;
+					}
+				}
+
+				// converting, non-contiguous or partial copies are written by a plain loop per host thread
+				parallel_host_for(range.size(), [&](size_t first, size_t last) {
+					copy_elements<value_type>(acc, offset, range, first, last, std::next(out, first));
+				});
+			};
 		}
 		else
 		{
-			static_assert(std::is_void_v<T>, "not supported");
-			//return [=](auto item) mutable { *out_copy++ = in_acc[item]; };
+			// output iterators can only be written in order
+			return [=]() {
+				const auto range = detail::distance(beg, end);
+				copy_elements<T>(in_acc.get_accessor(), *beg, range, 0, range.size(), out);
+			};
 		}
 	};
 }
 
 template <typename ExecutionPolicy, typename IteratorType, typename T, int Rank>
-auto copy(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, IteratorType out, int)
+auto copy_all(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, IteratorType out)
 {
 	return task<ExecutionPolicy>(copy_impl(p, beg, end, out));
 }
 
+// hands one block of rows to sink on the master, every block reads and writes the token,
+// so the blocks are handed over in order and sink is never invoked concurrently
+template <typename T, int Rank, typename Sink>
+auto copy_block_impl(buffer_iterator<T, Rank> beg, celerity::subrange<Rank> block, celerity::buffer<int, 1> token, const Sink &sink)
+{
+	using namespace cl::sycl::access;
+
+	return [=](celerity::handler &cgh) {
+		auto in_acc = beg.get_buffer().template get_access<mode::read, target::host_buffer>(cgh, celerity::access::fixed<Rank>(block));
+		token.template get_access<mode::read_write, target::host_buffer>(cgh, celerity::access::fixed<1>({{}, token.get_range()}));
+
+		return [=]() {
+			sink(block, host_block<T, Rank>{in_acc, block});
+		};
+	};
+}
+
+// submits a master task per block of rows_per_block rows of the first dimension, the runtime transfers
+// the next blocks to the master while sink processes the current one, so the master never waits for the whole range
+template <typename ExecutionPolicy, typename T, int Rank, typename Sink>
+auto copy_blocks(buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, size_t rows_per_block, const Sink &sink)
+{
+	using namespace traits;
+
+	using policy_type = strip_queue_t<ExecutionPolicy>;
+
+	static_assert(!policy_traits<policy_type>::is_distributed, "blocks are copied to the master");
+
+	return [=](distr_queue q) {
+		const auto offset = *beg;
+		const auto range = distance(beg, end);
+		const auto rows = std::max<size_t>(rows_per_block, 1);
+
+		const int initial_token = 0;
+		celerity::buffer<int, 1> token{&initial_token, cl::sycl::range<1>{1}};
+
+		for (size_t first = 0; first < range[0]; first += rows)
+		{
+			auto block = celerity::subrange<Rank>{offset, range};
+			block.offset[0] += first;
+			block.range[0] = std::min(rows, range[0] - first);
+
+			const auto t = task<non_blocking_master_execution_policy>(copy_block_impl(beg, block, token, sink));
+			t(q);
+		}
+
+		if constexpr (policy_traits<policy_type>::is_blocking)
+		{
+			q.slow_full_sync();
+		}
+	};
+}
+
+// writes the elements of sr from src, which holds [offset, offset + range) in row-major order
+template <typename T, typename InputIterator, typename Accessor, int Rank>
+void copy_in_subrange(InputIterator src, const Accessor &out_acc, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range, celerity::subrange<Rank> sr)
+{
+	cl::sycl::id<Rank> id{};
+
+	for (size_t i = 0, n = sr.range.size(); i < n; ++i, id = next(id, sr.range))
+	{
+		size_t linear_id = 0;
+
+		for (auto d = 0; d < Rank; ++d)
+		{
+			linear_id = linear_id * range[d] + (sr.offset[d] + id[d] - offset[d]);
+		}
+
+		out_acc[sr.offset + id] = static_cast<T>(*std::next(src, linear_id));
+	}
+}
+
+// every node holds its own copy of src, distributed policies write the buffer in a distributed host task,
+// so every node only writes the chunk it owns and the runtime never transfers the host data between nodes,
+// the host tasks run after the call returns, so they read a copy of src taken on submission
+template <typename ExecutionPolicy, typename InputIterator, typename T, int Rank>
+auto copy_in(InputIterator src, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using policy_type = strip_queue_t<ExecutionPolicy>;
+
+	return [=](distr_queue q) {
+		const auto offset = *beg;
+		const auto range = distance(beg, end);
+		const auto data = std::make_shared<const std::vector<T>>(src, std::next(src, count(range)));
+
+		if constexpr (policy_traits<policy_type>::is_distributed)
+		{
+			q.submit([=](celerity::handler &cgh) {
+				auto out_acc = beg.get_buffer().template get_access<mode::discard_write, target::host_buffer>(cgh, celerity::access::one_to_one<Rank>{});
+
+				cgh.host_task(range, offset, [=](celerity::partition<Rank> part) {
+					copy_in_subrange<T>(data->begin(), out_acc, offset, range, part.get_subrange());
+				});
+			});
+		}
+		else
+		{
+			q.submit([=](celerity::handler &cgh) {
+				auto out_acc = beg.get_buffer().template get_access<mode::discard_write, target::host_buffer>(cgh, celerity::access::fixed<Rank>({offset, range}));
+
+				cgh.host_task(celerity::on_master_node, [=]() {
+					copy_in_subrange<T>(data->begin(), out_acc, offset, range, celerity::subrange<Rank>{offset, range});
+				});
+			});
+
+			if constexpr (policy_traits<policy_type>::is_blocking)
+			{
+				q.slow_full_sync();
+			}
+		}
+	};
+}
+
 } // namespace detail
 
+// with master_async(q) the copy returns a std::future<void> which becomes ready once out has been written
 template <typename ExecutionPolicy, typename IteratorType, typename T, int Rank>
 auto copy(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, IteratorType out)
 {
-	return std::invoke(detail::copy(p, beg, end, out, 0), p.q);
+	if constexpr (traits::returns_future_v<ExecutionPolicy>)
+	{
+		return detail::submit_with_future(p.q, detail::copy_impl(p, beg, end, out));
+	}
+	else
+	{
+		return std::invoke(detail::copy_all(p, beg, end, out), p.q);
+	}
 }
 
 template <typename ExecutionPolicy, typename IteratorType, typename T, int Rank>
@@ -58,12 +262,71 @@ auto copy(ExecutionPolicy p, buffer<T, Rank> in, IteratorType out)
 	return copy(p, begin(in), end(in), out);
 }
 
+// streams [beg, end) to the master in blocks of rows_per_block rows of the first dimension,
+// sink(celerity::subrange<Rank> block, const host_block<T, Rank> &data) is invoked on the master for every block in order,
+// data reads the block from the buffer and is only valid during the call
+template <typename ExecutionPolicy, typename T, int Rank, typename Sink,
+		  require<std::is_invocable_v<Sink, celerity::subrange<Rank>, const host_block<T, Rank> &>> = yes>
+void copy(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, const Sink &sink, size_t rows_per_block)
+{
+	std::invoke(detail::copy_blocks<ExecutionPolicy>(beg, end, rows_per_block, sink), p.q);
+}
+
+// streams [beg, end) to the master in blocks of rows_per_block rows of the first dimension,
+// out receives the elements of the range in row-major order and must stay valid until the copy has completed
+template <typename ExecutionPolicy, typename IteratorType, typename T, int Rank,
+		  require<!std::is_invocable_v<IteratorType, celerity::subrange<Rank>, const host_block<T, Rank> &>> = yes>
+void copy(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, IteratorType out, size_t rows_per_block)
+{
+	static_assert(!traits::is_celerity_iterator_v<IteratorType>);
+
+	const auto first_row = (*beg)[0];
+	const auto row_size = detail::distance(beg, end).size() / std::max<size_t>(detail::distance(beg, end)[0], 1);
+
+	copy(p, beg, end, [out, first_row, row_size](celerity::subrange<Rank> block, const host_block<T, Rank> &data) {
+		data.copy_to(std::next(out, (block.offset[0] - first_row) * row_size));
+	}, rows_per_block);
+}
+
+template <typename ExecutionPolicy, typename OutputType, typename T, int Rank>
+void copy(ExecutionPolicy p, buffer<T, Rank> in, OutputType out, size_t rows_per_block)
+{
+	copy(p, begin(in), end(in), out, rows_per_block);
+}
+
 template <typename ExecutionPolicy, typename IteratorType, typename T, int Rank>
 auto copy(ExecutionPolicy p, buffer<T, Rank> in, buffer<T, Rank> out)
 {
 	return copy(p, begin(in), end(in), begin(out));
 }
 
+// writes the host range starting at src into [beg, end) of a buffer, src holds the elements in row-major order
+// and must be available on every node, it is copied before the call returns and may be changed right after it
+template <typename ExecutionPolicy, typename InputIterator, typename T, int Rank,
+		  require<!traits::is_celerity_iterator_v<InputIterator>> = yes>
+void copy(ExecutionPolicy p, InputIterator src, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end)
+{
+	static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>,
+				  "every node reads its part of the host range directly");
+
+	std::invoke(detail::copy_in<ExecutionPolicy>(src, beg, end), p.q);
+}
+
+// writes the host range starting at src into the subrange of out which the subrange specifiers select, e.g.
+// copy(distr<class ingest>(q), rows.data(), grid, skip<2>({n - 1, 0}), take<2>({1, n}))
+template <typename ExecutionPolicy, typename InputIterator, typename T, int Rank, typename... SubrangeSpecifiers,
+		  require<!traits::is_celerity_iterator_v<InputIterator>,
+				  (traits::is_iterator_transform_v<SubrangeSpecifiers> && ...)> = yes>
+void copy(ExecutionPolicy p, InputIterator src, buffer<T, Rank> out, SubrangeSpecifiers... specifiers)
+{
+	auto out_beg = begin(out);
+	auto out_end = end(out);
+
+	(std::invoke(specifiers, out_beg, out_end), ...);
+
+	copy(p, src, out_beg, out_end);
+}
+
 template <typename T, int Rank>
 auto make_buffer(T *data, cl::sycl::range<Rank> range) -> celerity::buffer<T, Rank>
 {
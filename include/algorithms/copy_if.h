@@ -0,0 +1,347 @@
+#ifndef COPY_IF_H
+#define COPY_IF_H
+
+#include "../iterator.h"
+#include "../task.h"
+#include "../accessor_proxy.h"
+#include "../policy.h"
+#include "../sequencing.h"
+#include "../require.h"
+#include "scan.h"
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace celerity::algorithm
+{
+
+// the output of a copy_if stage, elements holds exactly the size selected elements,
+// or a single unspecified element if no element is selected
+template <typename T>
+struct compacted_buffer
+{
+	buffer<T, 1> elements;
+	size_t size;
+};
+
+namespace detail
+{
+
+// the selected elements of every work group of the input, compacted to the front of the block of elements of the group
+template <typename T>
+struct compacted_blocks
+{
+	buffer<T, 1> elements;
+	// offsets[b] is the position of the first selected element of block b in the output, the last offset is their number
+	std::vector<size_t> offsets;
+	size_t block_size;
+
+	size_t size() const { return offsets.back(); }
+};
+
+// maps a chunk of the output to the blocks holding its elements
+struct compacted_block_mapper
+{
+	std::vector<size_t> offsets;
+	size_t out_offset;
+	size_t block_size;
+	size_t range;
+
+	celerity::subrange<1> operator()(celerity::chunk<1> chnk) const
+	{
+		if (chnk.range[0] == 0)
+		{
+			return {};
+		}
+
+		const auto block_of = [&](size_t i) { return static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), i) - offsets.begin()) - 1; };
+
+		const auto first = block_of(chnk.offset[0] - out_offset) * block_size;
+		const auto last = std::min((block_of(chnk.offset[0] - out_offset + chnk.range[0] - 1) + 1) * block_size, range);
+
+		return {cl::sycl::id<1>{first}, cl::sycl::range<1>{last - first}};
+	}
+};
+
+// every work group compacts the selected elements of its work items to the front of its block with a scan of their predicate flags and counts them,
+// producing stages of a pipeline are fused into this task
+template <typename ExecutionPolicy, typename ElementTask, typename Predicate, typename InputIterator, typename T>
+auto compact_impl(ElementTask element_task, InputIterator beg, InputIterator end, buffer<size_t, 1> counts, buffer<T, 1> elements, const Predicate &pred)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using element_kernel_type = std::invoke_result_t<decltype(element_task.get_sequence()), handler &>;
+	using element_context_type = std::decay_t<arg_type_t<element_kernel_type, 0>>;
+
+	const auto element_sequence = element_task.get_sequence();
+	const auto offset = *beg;
+	const auto range = distance(beg, end);
+
+	return [=](celerity::handler &cgh) {
+		const auto local_range = current_work_group_size<1>();
+		const auto kernels = sequence(std::invoke(element_sequence, cgh));
+
+		auto counts_acc = counts.template get_access<mode::discard_write>(cgh, work_group_mapper<1>{offset, local_range});
+		auto elements_acc = elements.template get_access<mode::discard_write>(cgh, scan_out_mapper<1>{offset, {}, range});
+
+		const auto tree_size = scan_tree_size(local_range);
+		local_accessor<reduction_partial<size_t>, 1> tree{cl::sycl::range<1>{tree_size}, cgh};
+
+		return [=](item_context<1, size_t()> &ctx) {
+			const auto group = ctx.get_group();
+			const auto id = ctx.get_item().get_id();
+			const auto local_id = group->get_local_linear_id();
+			const auto n = local_range[0];
+
+			T x{};
+			auto selected = false;
+
+			if (is_inside(id, offset, range))
+			{
+				element_context_type element_ctx{cl::sycl::detail::make_item(id, range, offset)};
+				kernels(element_ctx);
+
+				x = element_ctx.get_out().get();
+				selected = pred(x);
+			}
+
+			tree[cl::sycl::id<1>{local_id}] = {selected ? size_t{1} : size_t{0}, true};
+
+			if (local_id + n < tree_size)
+			{
+				tree[cl::sycl::id<1>{local_id + n}] = {0, true};
+			}
+
+			const auto selected_count = exclusive_group_scan<size_t>(*group, tree, tree_size, std::plus<size_t>{});
+			const auto before = tree[cl::sycl::id<1>{local_id}];
+
+			// the selected elements before this one in its group precede it in the block
+			if (selected)
+			{
+				elements_acc[cl::sycl::id<1>{id[0] - offset[0] - local_id + (before.valid ? before.value : 0)}] = x;
+			}
+
+			if (local_id == 0)
+			{
+				counts_acc[group->get_group_id()] = selected_count.value;
+			}
+		};
+	};
+}
+
+// every element of the output is read from the block holding it
+template <typename ExecutionPolicy, typename T>
+auto gather_compacted_impl(compacted_blocks<T> blocks, buffer<size_t, 1> offsets, buffer_iterator<T, 1> out, buffer_iterator<T, 1> out_end)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using policy_type = strip_queue_t<ExecutionPolicy>;
+
+	const auto out_offset = (*out)[0];
+	const auto block_size = blocks.block_size;
+	const auto block_count = blocks.offsets.size() - 1;
+
+	return [=](celerity::handler &cgh) {
+		auto elements_acc = blocks.elements.template get_access<mode::read>(cgh, compacted_block_mapper{blocks.offsets, out_offset, block_size, blocks.elements.get_range()[0]});
+		auto offsets_acc = offsets.template get_access<mode::read>(cgh, celerity::access::all<1, 1>());
+		auto out_acc = get_access<policy_type, mode::discard_write, one_to_one>(cgh, out, out_end);
+
+		return [=](item_context<1, T()> &ctx) {
+			const auto i = ctx.get_item()[0] - out_offset;
+
+			// the last block whose offset does not exceed i holds the element
+			size_t first = 0;
+			size_t last = block_count;
+
+			while (last - first > 1)
+			{
+				const auto mid = (first + last) / 2;
+				(offsets_acc[cl::sycl::id<1>{mid}] <= i ? first : last) = mid;
+			}
+
+			out_acc[ctx.get_out()] = elements_acc[cl::sycl::id<1>{first * block_size + i - offsets_acc[cl::sycl::id<1>{first}]}];
+		};
+	};
+}
+
+// every node reads the offsets of all blocks and the count of the last block, the number of selected elements is appended to the offsets
+inline std::future<std::vector<size_t>> gather_offsets(distr_queue q, buffer<size_t, 1> counts, buffer<size_t, 1> offsets)
+{
+	using namespace cl::sycl::access;
+
+	const auto block_count = counts.get_range()[0];
+
+	return submit_collective_with_future(q, [=](celerity::handler &cgh) {
+		auto offsets_acc = offsets.template get_access<mode::read, target::host_buffer>(cgh, celerity::access::all<1, 1>());
+		auto counts_acc = counts.template get_access<mode::read, target::host_buffer>(cgh, celerity::access::fixed<1>({cl::sycl::id<1>{block_count - 1}, cl::sycl::range<1>{1}}));
+
+		return [=](celerity::experimental::collective_partition) {
+			std::vector<size_t> result(block_count + 1);
+
+			for (size_t i = 0; i < block_count; ++i)
+			{
+				result[i] = offsets_acc[cl::sycl::id<1>{i}];
+			}
+
+			result[block_count] = result[block_count - 1] + counts_acc[cl::sycl::id<1>{block_count - 1}];
+			return result;
+		};
+	});
+}
+
+template <typename T, typename ExecutionPolicy, typename ElementTask, typename Predicate, template <typename, int> typename InIterator, typename U>
+compacted_blocks<T> compact_blocks(distr_queue q, ElementTask element_task, InIterator<U, 1> beg, InIterator<U, 1> end, const Predicate &pred)
+{
+	const auto range = distance(beg, end);
+	const auto local_range = reduction_work_group_size(range);
+	const auto block_count = padded_range(range, local_range)[0] / local_range[0];
+
+	buffer<size_t, 1> counts{cl::sycl::range<1>{block_count}};
+	buffer<size_t, 1> offsets{cl::sycl::range<1>{block_count}};
+	buffer<T, 1> elements{range};
+
+	using compact_policy = traits::internal_launch_t<ExecutionPolicy>;
+	using offsets_policy = named_distributed_execution_policy<nth_pass<typename traits::policy_traits<compact_policy>::kernel_name, 2>>;
+
+	// 1. every work group compacts and counts its selected elements on the node owning them
+	const auto compact = task<compact_policy>(compact_impl<compact_policy>(element_task, beg, end, counts, elements, pred));
+	compact(q, beg, end, local_range);
+
+	// 2. the distributed scan of the counts yields the offsets of the blocks in the output
+	std::invoke(scan<true, offsets_policy>(celerity::begin(counts), celerity::end(counts), celerity::begin(offsets), size_t{0}, true, std::plus<size_t>{}), q);
+
+	// 3. every node needs all offsets to locate the elements of its chunk of the output, only this waits for the device
+	return {elements, gather_offsets(q, counts, offsets).get(), local_range[0]};
+}
+
+template <typename ExecutionPolicy, typename T>
+void gather_compacted(distr_queue q, const compacted_blocks<T> &blocks, buffer_iterator<T, 1> out)
+{
+	if (blocks.size() == 0)
+	{
+		return;
+	}
+
+	auto out_end = out;
+	out_end += cl::sycl::id<1>{blocks.size()};
+
+	buffer<size_t, 1> offsets{blocks.offsets.data(), cl::sycl::range<1>{blocks.offsets.size()}};
+
+	using compact_policy = traits::internal_launch_t<ExecutionPolicy>;
+	using gather_policy = named_distributed_execution_policy<nth_pass<typename traits::policy_traits<compact_policy>::kernel_name, 3>>;
+
+	const auto gather = task<gather_policy>(gather_compacted_impl<gather_policy>(blocks, offsets, out, out_end));
+	gather(q, out, out_end);
+}
+
+template <typename ExecutionPolicy, typename ElementTask, typename Predicate, template <typename, int> typename InIterator, typename U, typename T>
+auto copy_if(ElementTask element_task, InIterator<U, 1> beg, InIterator<U, 1> end, buffer_iterator<T, 1> out, const Predicate &pred)
+{
+	static_assert(traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed, "copy_if requires a distributed execution policy");
+
+	return [=](distr_queue q) {
+		if (count(distance(beg, end)) == 0)
+		{
+			return size_t{0};
+		}
+
+		const auto blocks = compact_blocks<T, ExecutionPolicy>(q, element_task, beg, end, pred);
+		gather_compacted<ExecutionPolicy>(q, blocks, out);
+
+		return blocks.size();
+	};
+}
+
+template <typename ExecutionPolicy, typename Predicate, typename T>
+auto copy_if(buffer_iterator<T, 1> beg, buffer_iterator<T, 1> end, buffer_iterator<T, 1> out, const Predicate &pred)
+{
+	const auto element_task = task<ExecutionPolicy>(accumulate_elements_impl<ExecutionPolicy>(beg, end));
+	return copy_if<ExecutionPolicy>(element_task, beg, end, out, pred);
+}
+
+template <typename ExecutionPolicy, typename Predicate>
+auto copy_if(const Predicate &pred)
+{
+	using element_policy = traits::strip_queue_t<ExecutionPolicy>;
+	using value_type = std::decay_t<traits::arg_type_t<Predicate, 0>>;
+
+	return package_reduce<compacted_buffer<value_type>>(
+		[](auto beg, auto end) { return task<element_policy>(accumulate_elements_impl<element_policy>(beg, end)); },
+		[pred](distr_queue q, auto element_task, auto beg, auto end) {
+			if (count(distance(beg, end)) == 0)
+			{
+				return compacted_buffer<value_type>{buffer<value_type, 1>{cl::sycl::range<1>{1}}, 0};
+			}
+
+			const auto blocks = compact_blocks<value_type, ExecutionPolicy>(q, element_task, beg, end, pred);
+
+			buffer<value_type, 1> out{cl::sycl::range<1>{std::max<size_t>(blocks.size(), 1)}};
+			gather_compacted<ExecutionPolicy>(q, blocks, celerity::begin(out));
+
+			return compacted_buffer<value_type>{out, blocks.size()};
+		});
+}
+
+} // namespace detail
+
+// copies the elements of [beg, end) satisfying pred to [out, out + n) keeping their order and returns n on every node,
+// out has to provide room for all elements of [beg, end)
+template <typename ExecutionPolicy, typename T, typename Predicate>
+size_t copy_if(ExecutionPolicy p, buffer_iterator<T, 1> beg, buffer_iterator<T, 1> end, buffer_iterator<T, 1> out, const Predicate &pred)
+{
+	return std::invoke(detail::copy_if<ExecutionPolicy>(beg, end, out, pred), p.q);
+}
+
+template <typename ExecutionPolicy, typename T, typename Predicate>
+size_t copy_if(ExecutionPolicy p, buffer<T, 1> in, buffer<T, 1> out, const Predicate &pred)
+{
+	return copy_if(p, begin(in), end(in), begin(out), pred);
+}
+
+template <typename KernelName, typename T, typename Predicate>
+size_t copy_if(celerity::distr_queue q, buffer<T, 1> in, buffer<T, 1> out, const Predicate &pred)
+{
+	return copy_if(distr<KernelName>(q), begin(in), end(in), begin(out), pred);
+}
+
+// copies the elements of [beg, end) not satisfying pred, unlike std::remove_if the input is left untouched
+template <typename ExecutionPolicy, typename T, typename Predicate>
+size_t remove_if(ExecutionPolicy p, buffer_iterator<T, 1> beg, buffer_iterator<T, 1> end, buffer_iterator<T, 1> out, const Predicate &pred)
+{
+	return copy_if(p, beg, end, out, [pred](const T &x) { return !pred(x); });
+}
+
+template <typename ExecutionPolicy, typename T, typename Predicate>
+size_t remove_if(ExecutionPolicy p, buffer<T, 1> in, buffer<T, 1> out, const Predicate &pred)
+{
+	return remove_if(p, begin(in), end(in), begin(out), pred);
+}
+
+template <typename KernelName, typename T, typename Predicate>
+size_t remove_if(celerity::distr_queue q, buffer<T, 1> in, buffer<T, 1> out, const Predicate &pred)
+{
+	return remove_if(distr<KernelName>(q), begin(in), end(in), begin(out), pred);
+}
+
+// pipeline stages returning a compacted_buffer
+template <typename KernelName, typename Predicate>
+auto copy_if(const Predicate &pred)
+{
+	using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+	return detail::copy_if<execution_policy>(pred);
+}
+
+template <typename KernelName, typename Predicate>
+auto remove_if(const Predicate &pred)
+{
+	using value_type = std::decay_t<traits::arg_type_t<Predicate, 0>>;
+	return copy_if<KernelName>([pred](const value_type &x) { return !pred(x); });
+}
+
+} // namespace celerity::algorithm
+
+#endif // COPY_IF_H
@@ -0,0 +1,437 @@
+#ifndef FILE_H
+#define FILE_H
+
+#include "../iterator.h"
+#include "../policy.h"
+#include "../platform.h"
+#include "../require.h"
+#include "../sequencing.h"
+#include "../task.h"
+#include "../actions.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace celerity::algorithm
+{
+
+namespace detail
+{
+
+// maps the bytes [offset, offset + length) of an existing file, the mapping starts at the page containing offset,
+// a file which cannot be mapped is left unmapped and get_error() tells why
+class mapped_file
+{
+public:
+	mapped_file(const std::string &path, bool writable, size_t offset, size_t length)
+	{
+		fd_ = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+
+		if (fd_ < 0)
+		{
+			error_ = "cannot open " + path;
+			return;
+		}
+
+		if (struct stat st; ::fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < offset + length)
+		{
+			error_ = path + " is smaller than the requested range";
+			return;
+		}
+
+		const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+		padding_ = offset % page_size;
+		length_ = length + padding_;
+
+		if (length_ > 0)
+		{
+			map_ = ::mmap(nullptr, length_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, static_cast<off_t>(offset - padding_));
+
+			if (map_ == MAP_FAILED)
+			{
+				map_ = nullptr;
+				error_ = "cannot map " + path;
+				return;
+			}
+		}
+
+		mapped_ = true;
+	}
+
+	~mapped_file()
+	{
+		if (map_ != nullptr)
+		{
+			::munmap(map_, length_);
+		}
+
+		if (fd_ >= 0)
+		{
+			::close(fd_);
+		}
+	}
+
+	mapped_file(const mapped_file &) = delete;
+	mapped_file &operator=(const mapped_file &) = delete;
+
+	explicit operator bool() const { return mapped_; }
+
+	const std::string &get_error() const { return error_; }
+
+	// the byte at offset
+	char *data() const { return static_cast<char *>(map_) + padding_; }
+
+private:
+	int fd_ = -1;
+	void *map_ = nullptr;
+	size_t padding_ = 0;
+	size_t length_ = 0;
+	bool mapped_ = false;
+	std::string error_;
+};
+
+// creates the file or resizes it to size bytes, returns why this failed or an empty string
+inline std::string resize_file(const std::string &path, size_t size)
+{
+	const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0)
+	{
+		return "cannot open " + path;
+	}
+
+	const auto resized = ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+	::close(fd);
+
+	return resized ? std::string{} : "cannot resize " + path;
+}
+
+// linear id of id in the row-major layout of [offset, offset + range)
+template <int Rank>
+size_t file_position(cl::sycl::id<Rank> id, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+{
+	size_t linear_id = 0;
+
+	for (auto d = 0; d < Rank; ++d)
+	{
+		linear_id = linear_id * range[d] + (id[d] - offset[d]);
+	}
+
+	return linear_id;
+}
+
+// invokes f(id, pos) for every element of sr, pos is the position of the element relative to the first element of sr in the file
+template <int Rank, typename F>
+void for_each_file_element(cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range, celerity::subrange<Rank> sr, const F &f)
+{
+	const auto first = file_position(sr.offset, offset, range);
+
+	cl::sycl::id<Rank> id{};
+
+	for (size_t i = 0, n = sr.range.size(); i < n; ++i, id = next(id, sr.range))
+	{
+		f(sr.offset + id, file_position(sr.offset + id, offset, range) - first);
+	}
+}
+
+// number of elements in the file between the first and the last element of sr
+template <int Rank>
+size_t file_extent(cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range, celerity::subrange<Rank> sr)
+{
+	if (sr.range.size() == 0)
+	{
+		return 0;
+	}
+
+	auto last = sr.offset;
+
+	for (auto d = 0; d < Rank; ++d)
+	{
+		last[d] += sr.range[d] - 1;
+	}
+
+	return file_position(last, offset, range) - file_position(sr.offset, offset, range) + 1;
+}
+
+// tells every node whether all nodes of comm succeeded, error is empty on the nodes which succeeded,
+// the failure is thrown into the future of the file task or, where nobody holds that future, aborts the program
+inline void check_file_status(MPI_Comm comm, const std::string &error, bool abort_on_failure)
+{
+	const auto failed = all_gather(comm, static_cast<int>(!error.empty()));
+	const auto node = std::find(failed.begin(), failed.end(), 1);
+
+	if (node == failed.end())
+	{
+		return;
+	}
+
+	const auto message = error.empty() ? "file access failed on node " + std::to_string(node - failed.begin()) : error;
+
+	if (abort_on_failure)
+	{
+		on_error("file", message.c_str());
+		std::abort();
+	}
+
+	throw std::runtime_error(message);
+}
+
+// every node reads its share of the rows of buf from the file
+template <typename T, int Rank>
+std::future<void> read_file(celerity::distr_queue q, const std::string &path, celerity::buffer<T, Rank> buf, bool abort_on_failure)
+{
+	using namespace cl::sycl::access;
+
+	const auto range = buf.get_range();
+
+	return submit_collective_with_future(q, [=](celerity::handler &cgh) {
+		auto out_acc = buf.template get_access<mode::discard_write, target::host_buffer>(cgh, node_part_mapper<Rank>{range});
+
+		return [=](celerity::experimental::collective_partition part) {
+			const auto sr = node_part(range, part.get_subrange().offset[0], part.get_global_size()[0]);
+			const cl::sycl::id<Rank> offset{};
+
+			std::string error;
+
+			if (sr.range.size() > 0)
+			{
+				const mapped_file file{path, false, file_position(sr.offset, offset, range) * sizeof(T), file_extent(offset, range, sr) * sizeof(T)};
+				const auto *data = reinterpret_cast<const T *>(file.data());
+
+				if (file)
+				{
+					for_each_file_element(offset, range, sr, [&](cl::sycl::id<Rank> id, size_t pos) { out_acc[id] = data[pos]; });
+				}
+				else
+				{
+					error = file.get_error();
+				}
+			}
+
+			check_file_status(part.get_collective_mpi_comm(), error, abort_on_failure);
+		};
+	});
+}
+
+// the master sizes the file, then every node writes its share of the rows of [beg, end) to it
+template <typename T, int Rank>
+std::future<void> write_file(celerity::distr_queue q, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, const std::string &path, bool abort_on_failure)
+{
+	using namespace cl::sycl::access;
+
+	const auto offset = *beg;
+	const auto range = distance(beg, end);
+
+	return submit_collective_with_future(q, [=](celerity::handler &cgh) {
+		auto in_acc = beg.get_buffer().template get_access<mode::read, target::host_buffer>(cgh, node_part_mapper<Rank>{range, offset});
+
+		return [=](celerity::experimental::collective_partition part) {
+			const auto comm = part.get_collective_mpi_comm();
+			const auto node = part.get_subrange().offset[0];
+
+			// the nodes only map the file once the master has sized it
+			check_file_status(comm, node == 0 ? resize_file(path, range.size() * sizeof(T)) : std::string{}, abort_on_failure);
+
+			auto sr = node_part(range, node, part.get_global_size()[0]);
+			sr.offset += offset;
+
+			std::string error;
+
+			if (sr.range.size() > 0)
+			{
+				const mapped_file file{path, true, file_position(sr.offset, offset, range) * sizeof(T), file_extent(offset, range, sr) * sizeof(T)};
+				auto *data = reinterpret_cast<T *>(file.data());
+
+				if (file)
+				{
+					for_each_file_element(offset, range, sr, [&](cl::sycl::id<Rank> id, size_t pos) { data[pos] = in_acc[id]; });
+				}
+				else
+				{
+					error = file.get_error();
+				}
+			}
+
+			check_file_status(comm, error, abort_on_failure);
+		};
+	});
+}
+
+} // namespace detail
+
+// creates a buffer from a raw binary file holding range elements of T in row-major order, every node maps and reads
+// only the part of the file which covers its share of the rows, the returned future throws if any node failed to read the file
+template <typename T, int Rank>
+std::pair<celerity::buffer<T, Rank>, std::future<void>> from_file(celerity::distr_queue q, const std::string &path, cl::sycl::range<Rank> range)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "files hold the raw bytes of the elements");
+
+	celerity::buffer<T, Rank> buf{range};
+	auto done = detail::read_file(q, path, buf, false);
+
+	return {buf, std::move(done)};
+}
+
+// writes [beg, end) of a buffer to a raw binary file in row-major order, the master creates and sizes the file,
+// then every node maps and writes only the part of the file which covers its share of the rows,
+// the returned future throws if the file could not be sized or any node failed to write it
+template <typename T, int Rank>
+std::future<void> to_file(celerity::distr_queue q, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, const std::string &path)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "files hold the raw bytes of the elements");
+
+	return detail::write_file(q, beg, end, path, false);
+}
+
+template <typename T, int Rank>
+std::future<void> to_file(celerity::distr_queue q, celerity::buffer<T, Rank> in, const std::string &path)
+{
+	return to_file(q, begin(in), end(in), path);
+}
+
+namespace detail
+{
+
+// the stages of a file pipeline before any stage is appended
+struct no_file_stages
+{
+};
+
+} // namespace detail
+
+// a pipeline starting with a file, the stages appended to it are applied to the buffer the file is read into on submission
+template <typename T, int Rank, typename Stages = detail::no_file_stages>
+class file_pipeline
+{
+public:
+	file_pipeline(std::string path, cl::sycl::range<Rank> range, Stages stages = {})
+		: path_(std::move(path)), range_(range), stages_(stages) {}
+
+	const std::string &get_path() const { return path_; }
+	cl::sycl::range<Rank> get_range() const { return range_; }
+	const Stages &get_stages() const { return stages_; }
+
+private:
+	std::string path_;
+	cl::sycl::range<Rank> range_;
+	Stages stages_;
+};
+
+// the end of a pipeline writing its result to a file
+class file_sink
+{
+public:
+	explicit file_sink(std::string path) : path_(std::move(path)) {}
+
+	const std::string &get_path() const { return path_; }
+
+private:
+	std::string path_;
+};
+
+// a pipeline or buffer whose result is written to a file on submission
+template <typename Pipeline>
+class file_sink_pipeline
+{
+public:
+	file_sink_pipeline(Pipeline pipeline, std::string path)
+		: pipeline_(pipeline), path_(std::move(path)) {}
+
+	const Pipeline &get_pipeline() const { return pipeline_; }
+	const std::string &get_path() const { return path_; }
+
+private:
+	Pipeline pipeline_;
+	std::string path_;
+};
+
+// starts a pipeline with a raw binary file holding range elements of T in row-major order, e.g.
+// from_file<float>(path, range) | transform<class k>(f) | to_file(out_path) | submit_to(q),
+// pipelines hand out no future for the file access, so they abort the program if a node fails to read or write the file
+template <typename T, int Rank>
+auto from_file(std::string path, cl::sycl::range<Rank> range)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "files hold the raw bytes of the elements");
+
+	return file_pipeline<T, Rank>{std::move(path), range};
+}
+
+// ends a pipeline by writing its result to a raw binary file in row-major order, submitting the pipeline returns
+// the buffer holding the result as usual and aborts the program if the file cannot be written
+inline auto to_file(std::string path)
+{
+	return file_sink{std::move(path)};
+}
+
+template <typename T, int Rank, typename Stages, typename U,
+		  require<!std::is_same_v<U, celerity::distr_queue>, !std::is_same_v<U, file_sink>> = yes>
+auto operator|(file_pipeline<T, Rank, Stages> lhs, U rhs)
+{
+	const auto appended = [stages = lhs.get_stages(), rhs](celerity::buffer<T, Rank> buf) {
+		if constexpr (std::is_same_v<Stages, detail::no_file_stages>)
+		{
+			return buf | rhs;
+		}
+		else
+		{
+			return stages(buf) | rhs;
+		}
+	};
+
+	return file_pipeline<T, Rank, decltype(appended)>{lhs.get_path(), lhs.get_range(), appended};
+}
+
+template <typename T, int Rank, typename Stages>
+auto operator|(file_pipeline<T, Rank, Stages> lhs, celerity::distr_queue q)
+{
+	celerity::buffer<T, Rank> buf{lhs.get_range()};
+	detail::read_file(q, lhs.get_path(), buf, true);
+
+	if constexpr (std::is_same_v<Stages, detail::no_file_stages>)
+	{
+		return buf;
+	}
+	else
+	{
+		return lhs.get_stages()(buf) | q;
+	}
+}
+
+template <typename T>
+auto operator|(T lhs, file_sink rhs)
+{
+	return file_sink_pipeline<T>{lhs, rhs.get_path()};
+}
+
+template <typename Pipeline>
+auto operator|(file_sink_pipeline<Pipeline> lhs, celerity::distr_queue q)
+{
+	auto out = [&]() {
+		if constexpr (traits::is_celerity_buffer_v<Pipeline>)
+		{
+			return lhs.get_pipeline();
+		}
+		else
+		{
+			return lhs.get_pipeline() | q;
+		}
+	}();
+
+	detail::write_file(q, begin(out), end(out), lhs.get_path(), true);
+	return out;
+}
+
+} // namespace celerity::algorithm
+
+#endif // FILE_H
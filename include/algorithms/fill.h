@@ -52,10 +52,11 @@ auto fill(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Ra
     return std::invoke(detail::fill<ExecutionPolicy>(beg, end, value), p.q);
 }
 
-template <typename KernelName, typename T, int Rank>
+// fused tasks are launched in the work groups of their parts, so fills can request the groups of the stage they are fused with
+template <typename KernelName, size_t... LocalExtents, typename T, int Rank>
 auto fill_n(cl::sycl::range<Rank> range, const T &value)
 {
-    using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+    using execution_policy = detail::named_distributed_execution_policy<KernelName, LocalExtents...>;
     return detail::fill<execution_policy>(range, value);
 }
 
@@ -7,6 +7,7 @@
 #include "../policy.h"
 #include "../sequencing.h"
 #include "../require.h"
+#include "../host_threads.h"
 
 namespace celerity::algorithm
 {
@@ -22,7 +23,7 @@ namespace celerity::algorithm
 
             using policy_type = strip_queue_t<ExecutionPolicy>;
 
-            if constexpr (!policy_traits<std::decay_t<ExecutionPolicy>>::is_distributed)
+            if constexpr (!policy_traits<policy_type>::is_distributed)
             {
                 using accessor_type = algorithm::all<T, Rank>;
 
@@ -30,23 +31,30 @@ namespace celerity::algorithm
                     auto in_acc = get_access<policy_type, cl::sycl::access::mode::read, accessor_type>(cgh, beg, end);
 
                     return [=]() {
-                        for_each_index(beg, end, distance(beg, end), *beg, [f, in_acc](const cl::sycl::item<Rank> &item) {
-                            f(item, in_acc[item][item]);
-                        });
+                        const auto invoke_f = [f, in_acc](const cl::sycl::item<Rank> &item) {
+                            f(item, in_acc[item][item.get_id()]);
+                        };
+
+                        if constexpr (runs_on_host_threads_v<policy_type>)
+                        {
+                            parallel_for_each_index(distance(beg, end), *beg, invoke_f);
+                        }
+                        else
+                        {
+                            for_each_index(beg, end, distance(beg, end), *beg, invoke_f);
+                        }
                     };
                 };
             }
             else
             {
-                using accessor_type = accessor_type_t<F, 0, T>;
+                using accessor_type = accessor_type_t<F, 1, T>;
 
                 return [=](celerity::handler &cgh) {
                     auto in_acc = get_access<policy_type, cl::sycl::access::mode::read, accessor_type>(cgh, beg, end);
 
-                    return [=]() {
-                        for_each_index(beg, end, distance(beg, end), *beg, [f, in_acc](const cl::sycl::item<Rank> &item) {
-                            f(item, in_acc[item][item]);
-                        });
+                    return [=](item_context<Rank, void(T)> &ctx) {
+                        f(get_group_item(ctx), load_view(in_acc, ctx.get_in()));
                     };
                 };
             }
@@ -55,7 +63,16 @@ namespace celerity::algorithm
         template <typename ExecutionPolicy, typename T, int Rank, typename F>
         auto for_each(buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, const F &f)
         {
-            return task<ExecutionPolicy>(for_each_impl<ExecutionPolicy>(beg, end, f));
+            const auto t = task<ExecutionPolicy>(for_each_impl<ExecutionPolicy>(beg, end, f));
+
+            if constexpr (traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed)
+            {
+                return [=](distr_queue q) { t(q, beg, end); };
+            }
+            else
+            {
+                return t;
+            }
         }
 
     } // namespace detail
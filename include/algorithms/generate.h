@@ -28,7 +28,7 @@ auto generate_impl(IteratorType<T, Rank> beg, IteratorType<T, Rank> end, const F
         return [=](item_context<Rank, T()> &ctx) {
             if constexpr (traits::arity_v<F> == 1)
             {
-                out_acc[ctx.get_out()] = f(ctx.get_item());
+                out_acc[ctx.get_out()] = f(get_group_item(ctx));
             }
             else
             {
@@ -81,10 +81,11 @@ auto generate(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T
     return std::invoke(detail::generate<ExecutionPolicy>(beg, end, f), p.q);
 }
 
-template <typename KernelName, typename F, int Rank>
+// generators taking a group_item can synchronize with the work groups of LocalExtents
+template <typename KernelName, size_t... LocalExtents, typename F, int Rank>
 auto generate_n(cl::sycl::range<Rank> range, const F &f)
 {
-    using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+    using execution_policy = detail::named_distributed_execution_policy<KernelName, LocalExtents...>;
     return detail::generate<execution_policy>(range, f);
 }
 
@@ -0,0 +1,348 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "../iterator.h"
+#include "../task.h"
+#include "../accessor_proxy.h"
+#include "../policy.h"
+#include "../sequencing.h"
+#include "../require.h"
+#include "../actions.h"
+#include "accumulate.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace celerity::algorithm
+{
+
+namespace detail
+{
+
+// upper bound for the bins a work group counts in local memory, histograms with more bins are counted in several passes
+inline constexpr size_t max_local_bins = 4096;
+
+// the counts of all work groups hold at most this many bins, unless a single group counts more bins
+inline constexpr size_t max_group_bins = size_t{1} << 20;
+
+// work items count boxes of factor elements, they are launched in whole work groups of local_range
+template <int Rank>
+struct histogram_launch
+{
+	cl::sycl::range<Rank> factor;
+	cl::sycl::range<Rank> local_range;
+	cl::sycl::range<Rank> groups;
+};
+
+// the work groups are laid out like those of a reduction, the dimension with the most groups is coarsened
+// until the counts of all groups fit into max_group_bins, so the input is split over all of its dimensions
+template <int Rank>
+histogram_launch<Rank> histogram_launch_config(cl::sycl::range<Rank> range, size_t window)
+{
+	const auto max_groups = std::max<size_t>(max_group_bins / std::max<size_t>(window, 1), 1);
+	const auto local_range = reduction_work_group_size(range);
+
+	auto factor = range;
+	auto groups = range;
+
+	for (auto i = 0; i < Rank; ++i)
+	{
+		factor[i] = 1;
+		groups[i] = (range[i] + local_range[i] - 1) / local_range[i];
+	}
+
+	while (count(groups) > max_groups)
+	{
+		auto dim = 0;
+
+		for (auto i = 1; i < Rank; ++i)
+		{
+			dim = groups[i] > groups[dim] ? i : dim;
+		}
+
+		factor[dim] *= 2;
+		groups[dim] = (range[dim] + factor[dim] * local_range[dim] - 1) / (factor[dim] * local_range[dim]);
+	}
+
+	return {factor, local_range, groups};
+}
+
+// row-major index of a work group
+template <int Rank>
+size_t group_row(cl::sycl::id<Rank> group, cl::sycl::range<Rank> groups)
+{
+	size_t row = 0;
+
+	for (auto i = 0; i < Rank; ++i)
+	{
+		row = row * groups[i] + group[i];
+	}
+
+	return row;
+}
+
+// maps a chunk of work items to the rows of the counts of their groups, celerity splits launches along the
+// first dimension, so the groups of a chunk are the contiguous rows between its first and its last group
+template <int Rank>
+struct group_bins_mapper
+{
+	cl::sycl::range<Rank> local_range;
+	cl::sycl::range<Rank> groups;
+	size_t window;
+
+	celerity::subrange<2> operator()(celerity::chunk<Rank> chnk) const
+	{
+		const auto chunk_groups = work_group_mapper<Rank>{{}, local_range}(chnk);
+
+		auto last = chunk_groups.offset;
+
+		for (auto i = 0; i < Rank; ++i)
+		{
+			last[i] += chunk_groups.range[i] - 1;
+		}
+
+		const auto first_row = group_row(chunk_groups.offset, groups);
+		return {cl::sycl::id<2>{first_row, 0}, cl::sycl::range<2>{group_row(last, groups) + 1 - first_row, window}};
+	}
+};
+
+// local memory is counted through SYCL atomics, which exist for 32 and 64 bit integers
+template <typename C>
+void increment_local_bin(const local_accessor<C, 1> &bins, size_t bin)
+{
+	cl::sycl::atomic<C, cl::sycl::access::address_space::local_space>{bins.get_pointer() + bin}.fetch_add(C{1});
+}
+
+// every work group counts the elements of its work items in local bins, after a barrier the work items of the group
+// flush the counts of the group to its row of group_bins, so every row is written once and global memory is never
+// updated concurrently, only bins [first_bin, first_bin + window) are counted, producing stages of a pipeline are fused into this task
+template <typename ExecutionPolicy, typename ElementTask, typename BinFunction, template <typename, int> typename InIterator, typename U, typename C, int Rank>
+auto count_group_bins_impl(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, buffer<C, 2> group_bins, histogram_launch<Rank> launch, size_t first_bin, const BinFunction &bin_fn)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using element_kernel_type = std::invoke_result_t<decltype(element_task.get_sequence()), handler &>;
+	using element_context_type = std::decay_t<arg_type_t<element_kernel_type, 0>>;
+
+	const auto element_sequence = element_task.get_sequence();
+	const auto offset = *beg;
+	const auto range = distance(beg, end);
+	const auto window = group_bins.get_range()[1];
+
+	return [=](celerity::handler &cgh) {
+		// the element kernels request their inputs for the boxes of elements the work items count
+		const auto kernels = [&]() {
+			const element_launch_scope<Rank> scope{{}, launch.factor, offset, range};
+			return sequence(std::invoke(element_sequence, cgh));
+		}();
+
+		auto bins_acc = group_bins.template get_access<mode::discard_write>(cgh, group_bins_mapper<Rank>{launch.local_range, launch.groups, window});
+		local_accessor<C, 1> local_bins{cl::sycl::range<1>{window}, cgh};
+
+		return [=](item_context<Rank, void(C)> &ctx) {
+			const auto group = ctx.get_group();
+			const auto item = ctx.get_item().get_id();
+			const auto local_id = group->get_local_linear_id();
+			const auto n = count(launch.local_range);
+
+			for (auto i = local_id; i < window; i += n)
+			{
+				local_bins[cl::sycl::id<1>{i}] = C{};
+			}
+
+			group->barrier();
+
+			auto box_offset = offset;
+			auto box_range = range;
+			auto inside = true;
+
+			for (auto i = 0; i < Rank; ++i)
+			{
+				const auto first = item[i] * launch.factor[i];
+
+				inside = inside && first < range[i];
+				box_offset[i] += first;
+				box_range[i] = inside ? std::min(launch.factor[i], range[i] - first) : 0;
+			}
+
+			// the element kernels run outside of the group, only the counting synchronizes it
+			if (inside)
+			{
+				cl::sycl::id<Rank> id{};
+
+				for (size_t i = 0, m = count(box_range); i < m; ++i, id = next(id, box_range))
+				{
+					element_context_type element_ctx{cl::sycl::detail::make_item(box_offset + id, range, offset)};
+					kernels(element_ctx);
+
+					// elements outside of the bins are not counted
+					const size_t bin = bin_fn(element_ctx.get_out().get());
+
+					if (bin >= first_bin && bin - first_bin < window)
+					{
+						increment_local_bin(local_bins, bin - first_bin);
+					}
+				}
+			}
+
+			group->barrier();
+
+			const auto row = group_row(group->get_group_id(), launch.groups);
+
+			for (auto i = local_id; i < window; i += n)
+			{
+				bins_acc[cl::sycl::id<2>{row, i}] = local_bins[cl::sycl::id<1>{i}];
+			}
+		};
+	};
+}
+
+// every node merges the counts of the work groups in its share, the nodes then gather the merged bins of all nodes,
+// and every node adds them up for its share of the bins, so the counts of the groups are never sent to another node
+template <typename C>
+void merge_bins(distr_queue q, buffer<C, 2> group_bins, size_t group_count, buffer_iterator<C, 1> bins_beg, buffer_iterator<C, 1> bins_end)
+{
+	using namespace cl::sycl::access;
+
+	const auto bin_count = distance(bins_beg, bins_end)[0];
+	const auto bins_offset = *bins_beg;
+	const cl::sycl::range<2> groups_range{group_count, bin_count};
+
+	q.submit(celerity::allow_by_ref, [=](celerity::handler &cgh) {
+		auto group_bins_acc = group_bins.template get_access<mode::read, target::host_buffer>(cgh, node_part_mapper<2>{groups_range});
+		auto bins_acc = bins_beg.get_buffer().template get_access<mode::discard_write, target::host_buffer>(cgh, node_part_mapper<1>{cl::sycl::range<1>{bin_count}, bins_offset});
+
+		cgh.host_task(celerity::experimental::collective, [=](celerity::experimental::collective_partition part) {
+			const auto node = part.get_subrange().offset[0];
+			const auto nodes = part.get_global_size()[0];
+			const auto groups = node_part(groups_range, node, nodes);
+
+			std::vector<C> node_bins(bin_count);
+
+			for (auto g = groups.offset[0]; g < groups.offset[0] + groups.range[0]; ++g)
+			{
+				for (size_t i = 0; i < bin_count; ++i)
+				{
+					node_bins[i] += group_bins_acc[cl::sycl::id<2>{g, i}];
+				}
+			}
+
+			const auto all_bins = all_gather(part.get_collective_mpi_comm(), node_bins);
+			const auto bins = node_part(cl::sycl::range<1>{bin_count}, node, nodes);
+
+			for (auto i = bins.offset[0]; i < bins.offset[0] + bins.range[0]; ++i)
+			{
+				C sum{};
+
+				for (size_t n = 0; n < nodes; ++n)
+				{
+					sum += all_bins[n * bin_count + i];
+				}
+
+				bins_acc[bins_offset + cl::sycl::id<1>{i}] = sum;
+			}
+		});
+	});
+}
+
+template <typename ExecutionPolicy, typename ElementTask, typename BinFunction, template <typename, int> typename InIterator, typename U, typename C, int Rank>
+auto histogram(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, buffer<C, 1> bins, const BinFunction &bin_fn)
+{
+	static_assert(traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed, "histogram requires a distributed execution policy");
+	static_assert(std::is_integral_v<C> && (sizeof(C) == 4 || sizeof(C) == 8), "bins are counted with atomics, which exist for 32 and 64 bit integers");
+
+	return [=](distr_queue q) {
+		const auto range = distance(beg, end);
+		const auto bin_count = bins.get_range()[0];
+
+		using count_policy = traits::internal_launch_t<ExecutionPolicy>;
+
+		// every pass counts the next window of bins, the producing stages are evaluated again in every pass
+		for (size_t first_bin = 0; first_bin < bin_count; first_bin += max_local_bins)
+		{
+			const auto window = std::min(max_local_bins, bin_count - first_bin);
+			const auto launch = histogram_launch_config(range, window);
+			const auto group_count = count(launch.groups);
+
+			// 1. every work group counts the elements of its work items in local bins and flushes them once
+			buffer<C, 2> group_bins{cl::sycl::range<2>{std::max<size_t>(group_count, 1), window}};
+
+			if (group_count > 0)
+			{
+				auto items = launch.groups;
+
+				for (auto i = 0; i < Rank; ++i)
+				{
+					items[i] *= launch.local_range[i];
+				}
+
+				const auto count_bins = task<count_policy>(count_group_bins_impl<count_policy>(element_task, beg, end, group_bins, launch, first_bin, bin_fn));
+				count_bins(q, items, launch.local_range);
+			}
+
+			// 2. the counts of the groups are merged on every node and then across the nodes
+			auto window_beg = celerity::begin(bins);
+			window_beg += cl::sycl::id<1>{first_bin};
+			auto window_end = window_beg;
+			window_end += cl::sycl::id<1>{window};
+
+			merge_bins(q, group_bins, group_count, window_beg, window_end);
+		}
+	};
+}
+
+template <typename ExecutionPolicy, typename BinFunction, typename T, typename C, int Rank>
+auto histogram(buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, buffer<C, 1> bins, const BinFunction &bin_fn)
+{
+	const auto element_task = task<ExecutionPolicy>(accumulate_elements_impl<ExecutionPolicy>(beg, end));
+	return histogram<ExecutionPolicy>(element_task, beg, end, bins, bin_fn);
+}
+
+// the counts are returned as a new buffer of bin_count elements
+template <typename ExecutionPolicy, typename BinFunction>
+auto histogram(size_t bin_count, const BinFunction &bin_fn)
+{
+	using element_policy = traits::strip_queue_t<ExecutionPolicy>;
+
+	return package_reduce<buffer<size_t, 1>>(
+		[](auto beg, auto end) { return task<element_policy>(accumulate_elements_impl<element_policy>(beg, end)); },
+		[bin_count, bin_fn](distr_queue q, auto element_task, auto beg, auto end) {
+			buffer<size_t, 1> bins{cl::sycl::range<1>{bin_count}};
+			std::invoke(histogram<ExecutionPolicy>(element_task, beg, end, bins, bin_fn), q);
+			return bins;
+		});
+}
+
+} // namespace detail
+
+// bins[i] is the number of elements of [beg, end) for which bin_fn returns i, elements mapped to no bin are skipped
+template <typename ExecutionPolicy, typename BinFunction, typename T, typename C, int Rank>
+void histogram(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, buffer<C, 1> bins, const BinFunction &bin_fn)
+{
+	std::invoke(detail::histogram<ExecutionPolicy>(beg, end, bins, bin_fn), p.q);
+}
+
+template <typename ExecutionPolicy, typename BinFunction, typename T, typename C, int Rank>
+void histogram(ExecutionPolicy p, buffer<T, Rank> in, buffer<C, 1> bins, const BinFunction &bin_fn)
+{
+	histogram(p, begin(in), end(in), bins, bin_fn);
+}
+
+template <typename KernelName, typename BinFunction, typename T, typename C, int Rank>
+void histogram(celerity::distr_queue q, buffer<T, Rank> in, buffer<C, 1> bins, const BinFunction &bin_fn)
+{
+	histogram(distr<KernelName>(q), begin(in), end(in), bins, bin_fn);
+}
+
+// pipeline stage returning the counts of bin_count bins
+template <typename KernelName, typename BinFunction>
+auto histogram(size_t bin_count, const BinFunction &bin_fn)
+{
+	using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+	return detail::histogram<execution_policy>(bin_count, bin_fn);
+}
+
+} // namespace celerity::algorithm
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,220 @@
+#ifndef REDUCE_DIM_H
+#define REDUCE_DIM_H
+
+#include "../iterator.h"
+#include "../task.h"
+#include "../accessor_proxy.h"
+#include "../policy.h"
+#include "../sequencing.h"
+#include "../require.h"
+#include "accumulate.h"
+
+namespace celerity::algorithm
+{
+
+namespace detail
+{
+
+// the range of an input of rank Rank without its dimension Dim
+template <int Dim, int Rank>
+cl::sycl::range<Rank - 1> reduced_range(cl::sycl::range<Rank> range)
+{
+	cl::sycl::range<Rank - 1> reduced{};
+
+	for (int i = 0, j = 0; i < Rank; ++i)
+	{
+		if (i != Dim)
+		{
+			reduced[j++] = range[i];
+		}
+	}
+
+	return reduced;
+}
+
+// the position id of an element of an input of rank Rank without its dimension Dim, the position of the fold of its line
+template <int Dim, int Rank>
+cl::sycl::id<Rank - 1> reduced_id(cl::sycl::id<Rank> id)
+{
+	cl::sycl::id<Rank - 1> reduced{};
+
+	for (int i = 0, j = 0; i < Rank; ++i)
+	{
+		if (i != Dim)
+		{
+			reduced[j++] = id[i];
+		}
+	}
+
+	return reduced;
+}
+
+// the range of the first elements of the lines along Dim of an input of range, the work items of a reduction along Dim
+template <int Dim, int Rank>
+cl::sycl::range<Rank> line_range(cl::sycl::range<Rank> range)
+{
+	range[Dim] = 1;
+	return range;
+}
+
+// maps a chunk of the work items of a reduction along Dim, one per line of the input, to the output elements the lines are folded into
+template <int Dim, int Rank>
+struct reduce_dim_mapper
+{
+	cl::sycl::id<Rank> offset;
+	cl::sycl::id<Rank - 1> out_offset;
+
+	celerity::subrange<Rank - 1> operator()(celerity::chunk<Rank> chnk) const
+	{
+		celerity::subrange<Rank - 1> folds{};
+
+		for (int i = 0, j = 0; i < Rank; ++i)
+		{
+			if (i != Dim)
+			{
+				folds.offset[j] = out_offset[j] + chnk.offset[i] - offset[i];
+				folds.range[j] = chnk.range[i];
+				++j;
+			}
+		}
+
+		return folds;
+	}
+};
+
+// every work item folds the line of the input along Dim starting at its position,
+// producing stages of a pipeline are fused into this task
+template <int Dim, typename ExecutionPolicy, typename ElementTask, typename BinaryOp, template <typename, int> typename InIterator, typename U, typename T, int Rank>
+auto reduce_dim_impl(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, buffer_iterator<T, Rank - 1> out, const BinaryOp &op)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using element_kernel_type = std::invoke_result_t<decltype(element_task.get_sequence()), handler &>;
+	using element_context_type = std::decay_t<arg_type_t<element_kernel_type, 0>>;
+
+	const auto element_sequence = element_task.get_sequence();
+	const auto offset = *beg;
+	const auto out_offset = *out;
+	const auto range = distance(beg, end);
+
+	return [=](celerity::handler &cgh) {
+		// the element kernels request their inputs for the whole lines the work items fold
+		const auto kernels = [&]() {
+			auto factor = range;
+
+			for (int i = 0; i < Rank; ++i)
+			{
+				factor[i] = i == Dim ? range[i] : 1;
+			}
+
+			const element_launch_scope<Rank> scope{offset, factor, offset, range};
+			return sequence(std::invoke(element_sequence, cgh));
+		}();
+
+		auto out_acc = out.get_buffer().template get_access<mode::discard_write>(cgh, reduce_dim_mapper<Dim, Rank>{offset, out_offset});
+
+		return [=](item_context<Rank, T()> &ctx) {
+			const auto element = [&](cl::sycl::id<Rank> id) {
+				element_context_type element_ctx{cl::sycl::detail::make_item(id, range, offset)};
+				kernels(element_ctx);
+				return element_ctx.get_out().get();
+			};
+
+			auto id = ctx.get_item().get_id();
+			T sum = element(id);
+
+			for (size_t i = 1; i < range[Dim]; ++i)
+			{
+				id[Dim] = offset[Dim] + i;
+				sum = op(sum, element(id));
+			}
+
+			out_acc[out_offset + reduced_id<Dim>(ctx.get_item().get_id() - offset)] = sum;
+		};
+	};
+}
+
+template <int Dim, typename ExecutionPolicy, typename ElementTask, typename BinaryOp, template <typename, int> typename InIterator, typename U, typename T, int Rank>
+auto reduce_dim(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, buffer_iterator<T, Rank - 1> out, const BinaryOp &op)
+{
+	static_assert(traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed, "reduce_dim requires a distributed execution policy");
+	static_assert(Rank > 1 && Dim >= 0 && Dim < Rank, "reduce_dim reduces one of the dimensions of a buffer of rank 2 or 3");
+
+	return [=](distr_queue q) {
+		const auto range = distance(beg, end);
+
+		// lines of no elements have no fold
+		if (count(range) == 0)
+		{
+			return;
+		}
+
+		// one work item per line, placed at the first element of its line, so the range mappers of the task see chunks of the rank of the input
+		const auto lines = line_range<Dim>(range);
+		const iterator<Rank> lines_beg{*beg, lines};
+		const iterator<Rank> lines_end{*beg + cl::sycl::id<Rank>{lines}, lines};
+
+		using reduce_policy = traits::internal_launch_t<ExecutionPolicy>;
+
+		const auto reduce = task<reduce_policy>(reduce_dim_impl<Dim, reduce_policy>(element_task, beg, end, out, op));
+		reduce(q, lines_beg, lines_end);
+	};
+}
+
+template <int Dim, typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
+auto reduce_dim(buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, buffer_iterator<T, Rank - 1> out, const BinaryOp &op)
+{
+	const auto element_task = task<ExecutionPolicy>(accumulate_elements_impl<ExecutionPolicy>(beg, end));
+	return reduce_dim<Dim, ExecutionPolicy>(element_task, beg, end, out, op);
+}
+
+// the folded lines are returned as a new buffer of rank Rank - 1
+template <int Dim, typename ExecutionPolicy, int Rank, typename BinaryOp>
+auto reduce_dim(const BinaryOp &op)
+{
+	using element_policy = traits::strip_queue_t<ExecutionPolicy>;
+	using value_type = std::decay_t<traits::arg_type_t<BinaryOp, 0>>;
+
+	return package_reduce<buffer<value_type, Rank - 1>>(
+		[](auto beg, auto end) { return task<element_policy>(accumulate_elements_impl<element_policy>(beg, end)); },
+		[op](distr_queue q, auto element_task, auto beg, auto end) {
+			buffer<value_type, Rank - 1> out{reduced_range<Dim>(distance(beg, end))};
+			std::invoke(reduce_dim<Dim, ExecutionPolicy>(element_task, beg, end, celerity::begin(out), op), q);
+			return out;
+		});
+}
+
+} // namespace detail
+
+// out holds the folds of the lines of [beg, end) along Dim, out[i][j] of a two-dimensional input reduced along dimension 1
+// is the fold of the row i, the order in which elements of a line are combined is unspecified
+template <int Dim, typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
+void reduce_dim(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, buffer_iterator<T, Rank - 1> out, const BinaryOp &op)
+{
+	std::invoke(detail::reduce_dim<Dim, ExecutionPolicy>(beg, end, out, op), p.q);
+}
+
+template <int Dim, typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
+void reduce_dim(ExecutionPolicy p, buffer<T, Rank> in, buffer<T, Rank - 1> out, const BinaryOp &op)
+{
+	reduce_dim<Dim>(p, begin(in), end(in), begin(out), op);
+}
+
+template <typename KernelName, int Dim, typename BinaryOp, typename T, int Rank>
+void reduce_dim(celerity::distr_queue q, buffer<T, Rank> in, buffer<T, Rank - 1> out, const BinaryOp &op)
+{
+	reduce_dim<Dim>(distr<KernelName>(q), begin(in), end(in), begin(out), op);
+}
+
+// pipeline stage reducing an input of rank Rank along Dim, the result is returned as a new buffer
+template <typename KernelName, int Dim, int Rank = 2, typename BinaryOp>
+auto reduce_dim(const BinaryOp &op)
+{
+	using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+	return detail::reduce_dim<Dim, execution_policy, Rank>(op);
+}
+
+} // namespace celerity::algorithm
+
+#endif // REDUCE_DIM_H
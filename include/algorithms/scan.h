@@ -0,0 +1,413 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include "../iterator.h"
+#include "../task.h"
+#include "../accessor_proxy.h"
+#include "../policy.h"
+#include "../sequencing.h"
+#include "../require.h"
+#include "accumulate.h"
+
+namespace celerity::algorithm
+{
+
+namespace detail
+{
+
+// maps a chunk of the work items of a scan, which are launched for the elements of the input, to the elements of the output they write
+template <int Rank>
+struct scan_out_mapper
+{
+	cl::sycl::id<Rank> offset;
+	cl::sycl::id<Rank> out_offset;
+	cl::sycl::range<Rank> range;
+
+	celerity::subrange<Rank> operator()(celerity::chunk<Rank> chnk) const
+	{
+		celerity::subrange<Rank> sr{};
+
+		for (auto i = 0; i < Rank; ++i)
+		{
+			const auto first = std::min(chnk.offset[i] - offset[i], range[i]);
+			const auto last = std::min(first + chnk.range[i], range[i]);
+
+			sr.offset[i] = out_offset[i] + first;
+			sr.range[i] = last - first;
+		}
+
+		return sr;
+	}
+};
+
+// work items of the padded work groups past the end of the input have no element
+template <int Rank>
+bool is_inside(cl::sycl::id<Rank> id, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+{
+	auto inside = true;
+
+	for (auto i = 0; i < Rank; ++i)
+	{
+		inside = inside && id[i] < offset[i] + range[i];
+	}
+
+	return inside;
+}
+
+// number of leaves of the tree a work group of local_range scans in, the next power of two of its size
+template <int Rank>
+size_t scan_tree_size(cl::sycl::range<Rank> local_range)
+{
+	size_t tree_size = 1;
+
+	while (tree_size < count(local_range))
+	{
+		tree_size *= 2;
+	}
+
+	return tree_size;
+}
+
+// scans the partial results a work group stored in the leaves of tree with an up-sweep and a down-sweep over a balanced tree,
+// which combines every leaf O(1) times, afterwards tree[i] holds the fold of the leaves before i,
+// every work item receives the fold of all leaves
+template <typename T, int Rank, typename Tree, typename BinaryOp>
+reduction_partial<T> exclusive_group_scan(const work_group<Rank> &group, const Tree &tree, size_t tree_size, const BinaryOp &op)
+{
+	const auto local_id = group.get_local_linear_id();
+	const auto node = [&](size_t i) -> reduction_partial<T> & { return tree[cl::sycl::id<1>{i}]; };
+
+	// up-sweep: every inner node becomes the fold of its subtree
+	for (size_t stride = 1; stride < tree_size; stride *= 2)
+	{
+		group.barrier();
+
+		const auto right = (local_id + 1) * 2 * stride - 1;
+
+		if (right < tree_size)
+		{
+			node(right) = combine_partials(node(right - stride), node(right), op);
+		}
+	}
+
+	group.barrier();
+
+	const auto total = node(tree_size - 1);
+
+	group.barrier();
+
+	if (local_id == 0)
+	{
+		node(tree_size - 1) = reduction_partial<T>{};
+	}
+
+	// down-sweep: every node passes the fold of all leaves before its subtree to its left child,
+	// and combined with the fold of the left subtree to its right child
+	for (size_t stride = tree_size / 2; stride >= 1; stride /= 2)
+	{
+		group.barrier();
+
+		const auto right = (local_id + 1) * 2 * stride - 1;
+
+		if (right < tree_size)
+		{
+			const auto left = node(right - stride);
+
+			node(right - stride) = node(right);
+			node(right) = combine_partials(node(right), left, op);
+		}
+	}
+
+	group.barrier();
+
+	return total;
+}
+
+// every work group scans the elements of its work items in local memory and writes the scan of the group and the total of the group,
+// every element is evaluated exactly once and kept in the output for the fix-up pass
+template <bool Exclusive, typename ExecutionPolicy, typename ElementTask, typename BinaryOp, typename InputIterator, typename T, int Rank>
+auto scan_groups_impl(ElementTask element_task, InputIterator beg, InputIterator end, buffer_iterator<T, Rank> out, buffer<reduction_partial<T>, Rank> totals, const BinaryOp &op)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using element_kernel_type = std::invoke_result_t<decltype(element_task.get_sequence()), handler &>;
+	using element_context_type = std::decay_t<arg_type_t<element_kernel_type, 0>>;
+
+	const auto element_sequence = element_task.get_sequence();
+	const auto offset = *beg;
+	const auto out_offset = *out;
+	const auto range = distance(beg, end);
+
+	return [=](celerity::handler &cgh) {
+		const auto local_range = current_work_group_size<Rank>();
+		const auto kernels = sequence(std::invoke(element_sequence, cgh));
+
+		auto out_acc = out.get_buffer().template get_access<mode::discard_write>(cgh, scan_out_mapper<Rank>{offset, out_offset, range});
+		auto totals_acc = totals.template get_access<mode::discard_write>(cgh, work_group_mapper<Rank>{offset, local_range});
+
+		const auto tree_size = scan_tree_size(local_range);
+		local_accessor<reduction_partial<T>, 1> tree{cl::sycl::range<1>{tree_size}, cgh};
+
+		return [=](item_context<Rank, T()> &ctx) {
+			const auto group = ctx.get_group();
+			const auto id = ctx.get_item().get_id();
+			const auto local_id = group->get_local_linear_id();
+			const auto n = count(local_range);
+			const auto inside = is_inside(id, offset, range);
+
+			const auto node = [&](size_t i) -> reduction_partial<T> & { return tree[cl::sycl::id<1>{i}]; };
+
+			reduction_partial<T> element{};
+
+			if (inside)
+			{
+				element_context_type element_ctx{cl::sycl::detail::make_item(id, range, offset)};
+				kernels(element_ctx);
+
+				element = {T(element_ctx.get_out().get()), true};
+			}
+
+			node(local_id) = element;
+
+			if (local_id + n < tree_size)
+			{
+				node(local_id + n) = reduction_partial<T>{};
+			}
+
+			const auto total = exclusive_group_scan<T>(*group, tree, tree_size, op);
+
+			if (local_id == 0)
+			{
+				totals_acc[group->get_group_id()] = total;
+			}
+
+			if (inside)
+			{
+				const auto before = node(local_id);
+				const auto id_out = out_offset + (id - offset);
+
+				// the first element of an exclusive scan has nothing before it in its group, the fix-up pass only writes its carry
+				if constexpr (Exclusive)
+				{
+					out_acc[id_out] = before.value;
+				}
+				else
+				{
+					out_acc[id_out] = combine_partials(before, element, op).value;
+				}
+			}
+		};
+	};
+}
+
+// every node folds the totals of the work groups in its share of the rows and gathers the folds of all nodes,
+// the carry of a group is the fold of init, the totals of the preceding nodes and of the preceding groups of the node
+template <typename BinaryOp, typename T, int Rank>
+void scan_carries(distr_queue q, buffer<reduction_partial<T>, Rank> totals, buffer<reduction_partial<T>, Rank> carries, T init, bool has_init, const BinaryOp &op)
+{
+	using namespace cl::sycl::access;
+
+	const auto range = totals.get_range();
+
+	q.submit(celerity::allow_by_ref, [=](celerity::handler &cgh) {
+		auto totals_acc = totals.template get_access<mode::read, target::host_buffer>(cgh, node_part_mapper<Rank>{range});
+		auto carries_acc = carries.template get_access<mode::discard_write, target::host_buffer>(cgh, node_part_mapper<Rank>{range});
+
+		cgh.host_task(celerity::experimental::collective, [=](celerity::experimental::collective_partition part) {
+			const auto node = part.get_subrange().offset[0];
+			const auto sr = node_part(range, node, part.get_global_size()[0]);
+
+			reduction_partial<T> node_total{};
+			cl::sycl::id<Rank> id{};
+
+			for (size_t i = 0, n = count(sr.range); i < n; ++i, id = next(id, sr.range))
+			{
+				node_total = combine_partials(node_total, totals_acc[sr.offset + id], op);
+			}
+
+			const auto node_totals = all_gather(part.get_collective_mpi_comm(), node_total);
+
+			reduction_partial<T> carry{init, has_init};
+
+			for (size_t i = 0; i < node; ++i)
+			{
+				carry = combine_partials(carry, node_totals[i], op);
+			}
+
+			id = {};
+
+			for (size_t i = 0, n = count(sr.range); i < n; ++i, id = next(id, sr.range))
+			{
+				carries_acc[sr.offset + id] = carry;
+				carry = combine_partials(carry, totals_acc[sr.offset + id], op);
+			}
+		});
+	});
+}
+
+// every work item combines the carry of its group with its element of the scan of the group
+template <bool Exclusive, typename ExecutionPolicy, typename BinaryOp, typename T, int Rank>
+auto scan_fix_up_impl(cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range, buffer_iterator<T, Rank> out, buffer<reduction_partial<T>, Rank> carries, const BinaryOp &op)
+{
+	using namespace cl::sycl::access;
+
+	const auto out_offset = *out;
+
+	return [=](celerity::handler &cgh) {
+		const auto local_range = current_work_group_size<Rank>();
+
+		auto out_acc = out.get_buffer().template get_access<mode::read_write>(cgh, scan_out_mapper<Rank>{offset, out_offset, range});
+		auto carries_acc = carries.template get_access<mode::read>(cgh, work_group_mapper<Rank>{offset, local_range});
+
+		return [=](item_context<Rank, T()> &ctx) {
+			const auto group = ctx.get_group();
+			const auto id = ctx.get_item().get_id();
+
+			if (!is_inside(id, offset, range))
+			{
+				return;
+			}
+
+			const auto carry = carries_acc[group->get_group_id()];
+			const auto id_out = out_offset + (id - offset);
+
+			if constexpr (Exclusive)
+			{
+				out_acc[id_out] = group->get_local_linear_id() == 0 ? carry.value : combine_partials(carry, reduction_partial<T>{out_acc[id_out], true}, op).value;
+			}
+			else if (carry.valid)
+			{
+				out_acc[id_out] = op(carry.value, out_acc[id_out]);
+			}
+		};
+	};
+}
+
+template <bool Exclusive, typename ExecutionPolicy, typename ElementTask, typename BinaryOp, template <typename, int> typename InIterator, typename U, typename T, int Rank>
+auto scan(ElementTask element_task, InIterator<U, Rank> beg, InIterator<U, Rank> end, buffer_iterator<T, Rank> out, T init, bool has_init, const BinaryOp &op)
+{
+	static_assert(traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed, "scans require a distributed execution policy");
+
+	return [=](distr_queue q) {
+		const auto range = distance(beg, end);
+
+		if (count(range) == 0)
+		{
+			return;
+		}
+
+		const auto local_range = reduction_work_group_size(range);
+
+		auto groups = padded_range(range, local_range);
+
+		for (auto i = 0; i < Rank; ++i)
+		{
+			groups[i] /= local_range[i];
+		}
+
+		buffer<reduction_partial<T>, Rank> totals{groups};
+		buffer<reduction_partial<T>, Rank> carries{groups};
+
+		using scan_policy = traits::internal_launch_t<ExecutionPolicy>;
+		using fix_up_policy = named_distributed_execution_policy<nth_pass<typename traits::policy_traits<scan_policy>::kernel_name, 2>>;
+
+		// 1. every work group scans its elements on the node owning them
+		const auto scan_groups = task<scan_policy>(scan_groups_impl<Exclusive, scan_policy>(element_task, beg, end, out, totals, op));
+		scan_groups(q, beg, end, local_range);
+
+		// 2. every node computes the carries of its groups from the totals of all nodes
+		scan_carries(q, totals, carries, init, has_init, op);
+
+		// 3. every work item combines its element with the carry of its group
+		const auto fix_up = task<fix_up_policy>(scan_fix_up_impl<Exclusive, fix_up_policy>(*beg, range, out, carries, op));
+		fix_up(q, beg, end, local_range);
+	};
+}
+
+template <bool Exclusive, typename ExecutionPolicy, typename BinaryOp, typename U, typename T, int Rank>
+auto scan(buffer_iterator<U, Rank> beg, buffer_iterator<U, Rank> end, buffer_iterator<T, Rank> out, T init, bool has_init, const BinaryOp &op)
+{
+	const auto element_task = task<ExecutionPolicy>(accumulate_elements_impl<ExecutionPolicy>(beg, end));
+	return scan<Exclusive, ExecutionPolicy>(element_task, beg, end, out, init, has_init, op);
+}
+
+// the scanned buffer is created by the stage and returned on submission
+template <bool Exclusive, typename ExecutionPolicy, int Rank, typename BinaryOp, typename T>
+auto scan(T init, bool has_init, const BinaryOp &op)
+{
+	using element_policy = traits::strip_queue_t<ExecutionPolicy>;
+
+	return package_reduce<buffer<T, Rank>>(
+		[](auto beg, auto end) { return task<element_policy>(accumulate_elements_impl<element_policy>(beg, end)); },
+		[init, has_init, op](distr_queue q, auto element_task, auto beg, auto end) {
+			buffer<T, Rank> out{distance(beg, end)};
+			std::invoke(scan<Exclusive, ExecutionPolicy>(element_task, beg, end, celerity::begin(out), init, has_init, op), q);
+			return out;
+		});
+}
+
+} // namespace detail
+
+// out[i] is the fold of the elements [beg, beg + i] in row-major order
+template <typename ExecutionPolicy, typename BinaryOp, typename U, typename T, int Rank>
+void inclusive_scan(ExecutionPolicy p, buffer_iterator<U, Rank> beg, buffer_iterator<U, Rank> end, buffer_iterator<T, Rank> out, const BinaryOp &op)
+{
+	std::invoke(detail::scan<false, ExecutionPolicy>(beg, end, out, T{}, false, op), p.q);
+}
+
+template <typename ExecutionPolicy, typename BinaryOp, typename U, typename T, int Rank>
+void inclusive_scan(ExecutionPolicy p, buffer_iterator<U, Rank> beg, buffer_iterator<U, Rank> end, buffer_iterator<T, Rank> out, const BinaryOp &op, T init)
+{
+	std::invoke(detail::scan<false, ExecutionPolicy>(beg, end, out, init, true, op), p.q);
+}
+
+// out[i] is the fold of init and the elements [beg, beg + i) in row-major order
+template <typename ExecutionPolicy, typename BinaryOp, typename U, typename T, int Rank>
+void exclusive_scan(ExecutionPolicy p, buffer_iterator<U, Rank> beg, buffer_iterator<U, Rank> end, buffer_iterator<T, Rank> out, T init, const BinaryOp &op)
+{
+	std::invoke(detail::scan<true, ExecutionPolicy>(beg, end, out, init, true, op), p.q);
+}
+
+template <typename ExecutionPolicy, typename BinaryOp, typename U, typename T, int Rank>
+void inclusive_scan(ExecutionPolicy p, buffer<U, Rank> in, buffer<T, Rank> out, const BinaryOp &op)
+{
+	inclusive_scan(p, begin(in), end(in), begin(out), op);
+}
+
+template <typename ExecutionPolicy, typename BinaryOp, typename U, typename T, int Rank>
+void exclusive_scan(ExecutionPolicy p, buffer<U, Rank> in, buffer<T, Rank> out, T init, const BinaryOp &op)
+{
+	exclusive_scan(p, begin(in), end(in), begin(out), init, op);
+}
+
+template <typename KernelName, typename BinaryOp, typename U, typename T, int Rank>
+void inclusive_scan(celerity::distr_queue q, buffer<U, Rank> in, buffer<T, Rank> out, const BinaryOp &op)
+{
+	inclusive_scan(distr<KernelName>(q), begin(in), end(in), begin(out), op);
+}
+
+template <typename KernelName, typename BinaryOp, typename U, typename T, int Rank>
+void exclusive_scan(celerity::distr_queue q, buffer<U, Rank> in, buffer<T, Rank> out, T init, const BinaryOp &op)
+{
+	exclusive_scan(distr<KernelName>(q), begin(in), end(in), begin(out), init, op);
+}
+
+// pipeline stages, the scan of a Rank-dimensional input is returned as a new buffer
+template <typename KernelName, int Rank = 1, typename BinaryOp, typename T>
+auto inclusive_scan(const BinaryOp &op, T init)
+{
+	using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+	return detail::scan<false, execution_policy, Rank>(init, true, op);
+}
+
+template <typename KernelName, int Rank = 1, typename T, typename BinaryOp>
+auto exclusive_scan(T init, const BinaryOp &op)
+{
+	using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+	return detail::scan<true, execution_policy, Rank>(init, true, op);
+}
+
+} // namespace celerity::algorithm
+
+#endif // SCAN_H
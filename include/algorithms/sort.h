@@ -0,0 +1,683 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include "../iterator.h"
+#include "../task.h"
+#include "../accessor_proxy.h"
+#include "../policy.h"
+#include "../require.h"
+#include "scan.h"
+#include "transform.h"
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace celerity::algorithm
+{
+
+namespace detail
+{
+
+// every sorted block contributes this many samples to the choice of the bucket boundaries
+inline constexpr size_t sort_samples_per_block = 16;
+
+// the input is split into at most max_sort_blocks blocks of at least min_sort_block_size elements,
+// each block and each bucket is sorted by a work group of at most sort_work_group_size work items
+inline constexpr size_t min_sort_block_size = 1024;
+inline constexpr size_t max_sort_blocks = 1024;
+inline constexpr size_t sort_work_group_size = 256;
+
+// the policy of a kernel of a sort, the first kernel is named like the stage
+template <typename ExecutionPolicy, size_t Pass>
+using sort_pass_policy = std::conditional_t<Pass == 1,
+											traits::internal_launch_t<ExecutionPolicy>,
+											named_distributed_execution_policy<nth_pass<typename traits::policy_traits<traits::internal_launch_t<ExecutionPolicy>>::kernel_name, Pass>>>;
+
+// an element of a sort along with its position in the input, equal elements are ordered by their position, so no two
+// elements of a sort are equal and splitters divide runs of equal elements between buckets instead of putting them all into one
+template <typename T>
+struct ranked_element
+{
+	T value;
+	size_t rank;
+};
+
+template <typename Compare>
+struct ranked_compare
+{
+	Compare comp;
+
+	template <typename T>
+	bool operator()(const ranked_element<T> &a, const ranked_element<T> &b) const
+	{
+		if (comp(a.value, b.value))
+		{
+			return true;
+		}
+
+		if (comp(b.value, a.value))
+		{
+			return false;
+		}
+
+		return a.rank < b.rank;
+	}
+};
+
+// sorts the n elements element(0), ..., element(n - 1) with a bitonic sorting network whose comparators are distributed over the work items of group,
+// the network spans the next power of two of n, the missing elements are +inf and never move, so their comparators are skipped
+template <typename Element, typename Compare>
+void bitonic_sort(const work_group<1> &group, const Element &element, size_t n, const Compare &comp)
+{
+	size_t size = 1;
+
+	while (size < n)
+	{
+		size *= 2;
+	}
+
+	const auto local_id = group.get_local_linear_id();
+	const auto local_size = group.get_local_range()[0];
+
+	// every merge sorts ascending, its first step compares mirrored elements of the two sorted halves instead of reversing one of them
+	for (size_t k = 2; k <= size; k *= 2)
+	{
+		for (auto j = k / 2; j > 0; j /= 2)
+		{
+			for (auto p = local_id; p < size / 2; p += local_size)
+			{
+				const auto i = p / j * 2 * j + p % j;
+				const auto partner = j == k / 2 ? i ^ (k - 1) : i + j;
+
+				if (partner < n && comp(element(partner), element(i)))
+				{
+					const auto tmp = element(i);
+					element(i) = element(partner);
+					element(partner) = tmp;
+				}
+			}
+
+			group.barrier(cl::sycl::access::fence_space::global_and_local);
+		}
+	}
+}
+
+// position of the first element of the sorted elements element(first), ..., element(last - 1) which is not less than value
+template <typename Element, typename T, typename Compare>
+size_t sorted_lower_bound(const Element &element, size_t first, size_t last, const T &value, const Compare &comp)
+{
+	while (first < last)
+	{
+		const auto mid = first + (last - first) / 2;
+
+		if (comp(element(mid), value))
+		{
+			first = mid + 1;
+		}
+		else
+		{
+			last = mid;
+		}
+	}
+
+	return first;
+}
+
+// maps a chunk of the work items of a sort, one work group of local_size per block, to the block_size elements per block of a one-dimensional buffer
+struct sort_block_mapper
+{
+	cl::sycl::id<1> offset;
+	size_t size;
+	size_t block_size;
+	size_t local_size;
+
+	celerity::subrange<1> operator()(celerity::chunk<1> chnk) const
+	{
+		const auto groups = work_group_mapper<1>{{}, cl::sycl::range<1>{local_size}}(chnk);
+
+		const auto first = std::min(groups.offset[0] * block_size, size);
+		const auto last = std::min((groups.offset[0] + groups.range[0]) * block_size, size);
+
+		return {offset + cl::sycl::id<1>{first}, cl::sycl::range<1>{last - first}};
+	}
+};
+
+// maps a chunk of the work items of a sort, one work group of local_size per block, to the rows of the sorted blocks
+struct sort_row_mapper
+{
+	size_t block_size;
+	size_t local_size;
+
+	celerity::subrange<2> operator()(celerity::chunk<1> chnk) const
+	{
+		const auto groups = work_group_mapper<1>{{}, cl::sycl::range<1>{local_size}}(chnk);
+
+		return {cl::sycl::id<2>{groups.offset[0], 0}, cl::sycl::range<2>{groups.range[0], block_size}};
+	}
+};
+
+// maps a chunk of buckets, one per local_size work items, to the columns of the bucket bounds of all blocks which delimit them
+struct bucket_bounds_mapper
+{
+	size_t block_count;
+	size_t bucket_count;
+	size_t local_size;
+
+	celerity::subrange<2> operator()(celerity::chunk<1> chnk) const
+	{
+		const auto buckets = work_group_mapper<1>{{}, cl::sycl::range<1>{local_size}}(chnk);
+
+		const auto first = buckets.offset[0];
+		const auto last = std::min(first + buckets.range[0] + 1, bucket_count + 1);
+
+		return {cl::sycl::id<2>{0, first}, cl::sycl::range<2>{block_count, last - first}};
+	}
+};
+
+// maps a chunk of buckets, one per local_size work items, to the offsets of their parts of the output
+struct bucket_offsets_mapper
+{
+	size_t bucket_count;
+	size_t local_size;
+
+	celerity::subrange<1> operator()(celerity::chunk<1> chnk) const
+	{
+		const auto buckets = work_group_mapper<1>{{}, cl::sycl::range<1>{local_size}}(chnk);
+
+		const auto first = buckets.offset[0];
+		const auto last = std::min(first + buckets.range[0] + 1, bucket_count + 1);
+
+		return {cl::sycl::id<1>{first}, cl::sycl::range<1>{last - first}};
+	}
+};
+
+// bounds of the columns of the sorted blocks holding the elements before a splitter, and the size of the bucket starting at it
+struct bucket_boundary
+{
+	size_t first;
+	size_t last;
+	size_t size;
+};
+
+// where the buckets are read from and written to, known on every node
+struct bucket_layout
+{
+	// the elements of buckets [a, b) lie in the columns [first[a], last[b]) of the sorted blocks
+	std::vector<size_t> first;
+	std::vector<size_t> last;
+	// offsets[k] is the position of bucket k in the output, the last offset is the number of elements
+	std::vector<size_t> offsets;
+};
+
+// maps a chunk of buckets, one per local_size work items, to the columns of the sorted blocks holding their elements,
+// so every node only receives the elements of its buckets
+struct bucket_elements_mapper
+{
+	std::vector<size_t> first;
+	std::vector<size_t> last;
+	size_t block_count;
+	size_t local_size;
+
+	celerity::subrange<2> operator()(celerity::chunk<1> chnk) const
+	{
+		const auto buckets = work_group_mapper<1>{{}, cl::sycl::range<1>{local_size}}(chnk);
+
+		if (buckets.range[0] == 0)
+		{
+			return {};
+		}
+
+		const auto a = first[buckets.offset[0]];
+		const auto b = last[buckets.offset[0] + buckets.range[0]];
+
+		return {cl::sycl::id<2>{0, a}, cl::sycl::range<2>{block_count, b - a}};
+	}
+};
+
+// maps a chunk of buckets, one per local_size work items, to the part of the output they are sorted into
+struct bucket_mapper
+{
+	std::vector<size_t> offsets;
+	size_t out_offset;
+	size_t local_size;
+
+	celerity::subrange<1> operator()(celerity::chunk<1> chnk) const
+	{
+		const auto buckets = work_group_mapper<1>{{}, cl::sycl::range<1>{local_size}}(chnk);
+
+		const auto first = offsets[buckets.offset[0]];
+		const auto last = offsets[buckets.offset[0] + buckets.range[0]];
+
+		return {cl::sycl::id<1>{out_offset + first}, cl::sycl::range<1>{last - first}};
+	}
+};
+
+// every work group copies a block of the input ranked by position into its row of blocks, sorts it and takes evenly spaced samples of it
+template <typename ExecutionPolicy, typename T, typename Compare>
+auto sort_blocks_impl(buffer_iterator<T, 1> beg, buffer_iterator<T, 1> end, buffer<ranked_element<T>, 2> blocks, buffer<ranked_element<T>, 1> samples, const Compare &comp)
+{
+	using namespace cl::sycl::access;
+
+	const auto offset = *beg;
+	const auto size = distance(beg, end)[0];
+	const auto block_size = blocks.get_range()[1];
+
+	return [=](celerity::handler &cgh) {
+		const auto local_size = current_work_group_size<1>()[0];
+
+		auto in_acc = beg.get_buffer().template get_access<mode::read>(cgh, sort_block_mapper{offset, size, block_size, local_size});
+		auto blocks_acc = blocks.template get_access<mode::discard_read_write>(cgh, sort_row_mapper{block_size, local_size});
+		auto samples_acc = samples.template get_access<mode::discard_write>(cgh, sort_block_mapper{{}, samples.get_range()[0], sort_samples_per_block, local_size});
+
+		return [=](item_context<1, void(size_t)> &ctx) {
+			const auto group = ctx.get_group();
+			const auto local_id = group->get_local_linear_id();
+			const auto block = group->get_group_id()[0];
+			const auto first = block * block_size;
+			const auto n = std::min(block_size, size - first);
+
+			const auto element = [&](size_t i) -> ranked_element<T> & { return blocks_acc[cl::sycl::id<2>{block, i}]; };
+
+			for (auto i = local_id; i < n; i += local_size)
+			{
+				element(i) = {in_acc[offset + cl::sycl::id<1>{first + i}], first + i};
+			}
+
+			group->barrier(cl::sycl::access::fence_space::global_and_local);
+
+			bitonic_sort(*group, element, n, comp);
+
+			for (auto j = local_id; j < sort_samples_per_block; j += local_size)
+			{
+				samples_acc[cl::sycl::id<1>{block * sort_samples_per_block + j}] = element(j * n / sort_samples_per_block);
+			}
+		};
+	};
+}
+
+// the master sorts the samples and takes bucket_count - 1 evenly spaced splitters from them
+template <typename T, typename Compare>
+auto choose_splitters_impl(buffer<T, 1> samples, buffer<T, 1> splitters, size_t bucket_count, const Compare &comp)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using policy_type = non_blocking_master_execution_policy;
+
+	return [=](celerity::handler &cgh) {
+		auto samples_acc = get_access<policy_type, mode::read, all<T, 1>>(cgh, celerity::begin(samples), celerity::end(samples));
+		auto splitters_acc = get_access<policy_type, mode::discard_write, all<T, 1>>(cgh, celerity::begin(splitters), celerity::end(splitters));
+
+		return [=]() {
+			std::vector<T> sorted(samples.get_range()[0]);
+
+			for (size_t i = 0; i < sorted.size(); ++i)
+			{
+				sorted[i] = samples_acc.get_accessor()[cl::sycl::id<1>{i}];
+			}
+
+			std::sort(sorted.begin(), sorted.end(), comp);
+
+			for (size_t k = 1; k < bucket_count; ++k)
+			{
+				splitters_acc.get_accessor()[cl::sycl::id<1>{k - 1}] = sorted[k * sorted.size() / bucket_count];
+			}
+		};
+	};
+}
+
+// every work item finds the position of a splitter in a sorted block, bucket k of the block lies between the positions of the splitters k - 1 and k
+template <typename ExecutionPolicy, typename T, typename Compare>
+auto bucket_bounds_impl(buffer<T, 2> blocks, buffer<T, 1> splitters, buffer<size_t, 2> bounds, size_t size, const Compare &comp)
+{
+	using namespace cl::sycl::access;
+
+	const auto block_size = blocks.get_range()[1];
+	const auto bucket_count = bounds.get_range()[1] - 1;
+
+	return [=](celerity::handler &cgh) {
+		auto blocks_acc = blocks.template get_access<mode::read>(cgh, celerity::access::slice<2>(1));
+		auto splitters_acc = splitters.template get_access<mode::read>(cgh, celerity::access::all<2, 1>());
+		auto bounds_acc = bounds.template get_access<mode::discard_write>(cgh, celerity::access::one_to_one<2>());
+
+		return [=](item_context<2, void(size_t)> &ctx) {
+			const auto id = ctx.get_item().get_id();
+			const auto block = id[0];
+			const auto k = id[1];
+			const auto n = std::min(block_size, size - block * block_size);
+
+			const auto element = [&](size_t i) { return blocks_acc[cl::sycl::id<2>{block, i}]; };
+
+			if (k == 0 || k == bucket_count)
+			{
+				bounds_acc[id] = k == 0 ? 0 : n;
+			}
+			else
+			{
+				bounds_acc[id] = sorted_lower_bound(element, 0, n, splitters_acc[cl::sycl::id<1>{k - 1}], comp);
+			}
+		};
+	};
+}
+
+// every work item collects the bounds of a splitter in all blocks and the size of the bucket starting at it
+template <typename ExecutionPolicy>
+auto bucket_boundaries_impl(buffer<size_t, 2> bounds, buffer<bucket_boundary, 1> boundaries)
+{
+	using namespace cl::sycl::access;
+
+	const auto block_count = bounds.get_range()[0];
+	const auto bucket_count = bounds.get_range()[1] - 1;
+
+	return [=](celerity::handler &cgh) {
+		auto bounds_acc = bounds.template get_access<mode::read>(cgh, bucket_bounds_mapper{block_count, bucket_count, 1});
+		auto boundaries_acc = boundaries.template get_access<mode::discard_write>(cgh, celerity::access::one_to_one<1>());
+
+		return [=](item_context<1, void(size_t)> &ctx) {
+			const auto k = ctx.get_item()[0];
+
+			bucket_boundary boundary{bounds_acc[cl::sycl::id<2>{0, k}], 0, 0};
+
+			for (size_t b = 0; b < block_count; ++b)
+			{
+				const auto bound = bounds_acc[cl::sycl::id<2>{b, k}];
+
+				boundary.first = std::min(boundary.first, bound);
+				boundary.last = std::max(boundary.last, bound);
+
+				if (k < bucket_count)
+				{
+					boundary.size += bounds_acc[cl::sycl::id<2>{b, k + 1}] - bound;
+				}
+			}
+
+			boundaries_acc[ctx.get_item().get_id()] = boundary;
+		};
+	};
+}
+
+// every node reads the boundaries of all buckets, they are few, and scans their sizes into the offsets of the buckets in the output
+inline std::future<bucket_layout> gather_bucket_layout(distr_queue q, buffer<bucket_boundary, 1> boundaries)
+{
+	using namespace cl::sycl::access;
+
+	const auto boundary_count = boundaries.get_range()[0];
+
+	return submit_collective_with_future(q, [=](celerity::handler &cgh) {
+		auto boundaries_acc = boundaries.template get_access<mode::read, target::host_buffer>(cgh, celerity::access::all<1, 1>());
+
+		return [=](celerity::experimental::collective_partition) {
+			bucket_layout layout;
+			layout.offsets.push_back(0);
+
+			for (size_t k = 0; k < boundary_count; ++k)
+			{
+				const auto boundary = boundaries_acc[cl::sycl::id<1>{k}];
+
+				layout.first.push_back(boundary.first);
+				layout.last.push_back(boundary.last);
+
+				if (k + 1 < boundary_count)
+				{
+					layout.offsets.push_back(layout.offsets.back() + boundary.size);
+				}
+			}
+
+			return layout;
+		};
+	});
+}
+
+// every work group gathers the parts of a bucket from all blocks into its part of the output and sorts it there,
+// the work items copy the parts of one block each, their positions are the scan of the sizes of the parts
+template <typename ExecutionPolicy, typename T, typename Compare>
+auto sort_buckets_impl(buffer<T, 2> blocks, buffer<size_t, 2> bounds, buffer<size_t, 1> offsets, const bucket_layout &layout, buffer_iterator<T, 1> out, const Compare &comp)
+{
+	using namespace cl::sycl::access;
+
+	const auto block_count = blocks.get_range()[0];
+	const auto bucket_count = bounds.get_range()[1] - 1;
+	const auto out_offset = (*out)[0];
+
+	return [=, first = layout.first, last = layout.last, host_offsets = layout.offsets](celerity::handler &cgh) {
+		const auto local_size = current_work_group_size<1>()[0];
+
+		auto blocks_acc = blocks.template get_access<mode::read>(cgh, bucket_elements_mapper{first, last, block_count, local_size});
+		auto bounds_acc = bounds.template get_access<mode::read>(cgh, bucket_bounds_mapper{block_count, bucket_count, local_size});
+		auto offsets_acc = offsets.template get_access<mode::read>(cgh, bucket_offsets_mapper{bucket_count, local_size});
+		auto out_acc = out.get_buffer().template get_access<mode::discard_read_write>(cgh, bucket_mapper{host_offsets, out_offset, local_size});
+
+		const auto tree_size = scan_tree_size(cl::sycl::range<1>{local_size});
+		local_accessor<reduction_partial<size_t>, 1> tree{cl::sycl::range<1>{tree_size}, cgh};
+
+		return [=](item_context<1, void(size_t)> &ctx) {
+			const auto group = ctx.get_group();
+			const auto local_id = group->get_local_linear_id();
+			const auto bucket = group->get_group_id()[0];
+
+			const auto first_out = out_offset + offsets_acc[cl::sycl::id<1>{bucket}];
+			const auto n = offsets_acc[cl::sycl::id<1>{bucket + 1}] - offsets_acc[cl::sycl::id<1>{bucket}];
+
+			auto pos = first_out;
+
+			for (size_t base = 0; base < block_count; base += local_size)
+			{
+				const auto block = base + local_id;
+				const auto part_first = block < block_count ? bounds_acc[cl::sycl::id<2>{block, bucket}] : 0;
+				const auto part_last = block < block_count ? bounds_acc[cl::sycl::id<2>{block, bucket + 1}] : 0;
+
+				tree[cl::sycl::id<1>{local_id}] = {part_last - part_first, true};
+
+				if (local_id + local_size < tree_size)
+				{
+					tree[cl::sycl::id<1>{local_id + local_size}] = {0, true};
+				}
+
+				const auto total = exclusive_group_scan<size_t>(*group, tree, tree_size, std::plus<size_t>{});
+				const auto before = tree[cl::sycl::id<1>{local_id}];
+
+				auto part_pos = pos + (before.valid ? before.value : 0);
+
+				for (auto i = part_first; i < part_last; ++i, ++part_pos)
+				{
+					out_acc[cl::sycl::id<1>{part_pos}] = blocks_acc[cl::sycl::id<2>{block, i}];
+				}
+
+				pos += total.value;
+			}
+
+			group->barrier(cl::sycl::access::fence_space::global_and_local);
+
+			bitonic_sort(*group, [&](size_t i) -> T & { return out_acc[cl::sycl::id<1>{first_out + i}]; }, n, comp);
+		};
+	};
+}
+
+// sample sort: every work group sorts a block of the input, the master chooses the splitters of the buckets from samples of the sorted blocks,
+// and every work group gathers the elements between two splitters, the bucket, from the parts of all blocks and sorts them,
+// elements are sorted along with their position in the input, which breaks ties, so the sort is stable and many equal elements
+// are spread over several buckets instead of being sorted by a single work group
+template <typename ExecutionPolicy, typename T, typename Compare>
+auto sort(buffer_iterator<T, 1> beg, buffer_iterator<T, 1> end, const Compare &comp)
+{
+	static_assert(traits::policy_traits<traits::strip_queue_t<ExecutionPolicy>>::is_distributed, "sort requires a distributed execution policy");
+	static_assert(std::is_trivially_copyable_v<T>, "sorted elements are copied between buffers");
+
+	using element_type = ranked_element<T>;
+
+	return [=](distr_queue q) {
+		const auto size = distance(beg, end)[0];
+
+		if (size < 2)
+		{
+			return;
+		}
+
+		const auto block_count = std::clamp<size_t>(size / min_sort_block_size, 1, max_sort_blocks);
+		const auto block_size = (size + block_count - 1) / block_count;
+		const auto bucket_count = block_count;
+
+		const cl::sycl::range<1> local_range{std::min(sort_work_group_size, block_size)};
+		const cl::sycl::range<1> groups_range{block_count * local_range[0]};
+
+		const ranked_compare<Compare> ranked_comp{comp};
+
+		// 1. sort the blocks and sample them
+		buffer<element_type, 2> blocks{cl::sycl::range<2>{block_count, block_size}};
+		buffer<element_type, 1> samples{cl::sycl::range<1>{block_count * sort_samples_per_block}};
+
+		using sort_blocks_policy = sort_pass_policy<ExecutionPolicy, 1>;
+
+		const auto sort_blocks = task<sort_blocks_policy>(sort_blocks_impl<sort_blocks_policy>(beg, end, blocks, samples, ranked_comp));
+		sort_blocks(q, groups_range, local_range);
+
+		// 2. one bucket per block, the buckets hold similar numbers of elements as no two ranked elements are equal
+		buffer<element_type, 1> splitters{cl::sycl::range<1>{std::max<size_t>(bucket_count - 1, 1)}};
+
+		const auto choose_splitters = task<non_blocking_master_execution_policy>(choose_splitters_impl(samples, splitters, bucket_count, ranked_comp));
+		choose_splitters(q);
+
+		buffer<size_t, 2> bounds{cl::sycl::range<2>{block_count, bucket_count + 1}};
+
+		using bucket_bounds_policy = sort_pass_policy<ExecutionPolicy, 2>;
+
+		const auto bucket_bounds = task<bucket_bounds_policy>(bucket_bounds_impl<bucket_bounds_policy>(blocks, splitters, bounds, size, ranked_comp));
+		bucket_bounds(q, bounds.get_range());
+
+		buffer<bucket_boundary, 1> boundaries{cl::sycl::range<1>{bucket_count + 1}};
+
+		using bucket_boundaries_policy = sort_pass_policy<ExecutionPolicy, 3>;
+
+		const auto bucket_boundaries = task<bucket_boundaries_policy>(bucket_boundaries_impl<bucket_boundaries_policy>(bounds, boundaries));
+		bucket_boundaries(q, boundaries.get_range());
+
+		// 3. every node needs the layout of all buckets to know which columns of the blocks its buckets read and which part of the output they write
+		const auto layout = gather_bucket_layout(q, boundaries).get();
+		buffer<size_t, 1> offsets{layout.offsets.data(), cl::sycl::range<1>{layout.offsets.size()}};
+
+		// the sorted elements lie at the same positions as [beg, end), so the ranks are dropped element by element
+		buffer<element_type, 1> sorted{beg.get_buffer().get_range()};
+
+		auto sorted_beg = celerity::begin(sorted);
+		sorted_beg += *beg;
+
+		auto sorted_end = celerity::begin(sorted);
+		sorted_end += *end;
+
+		using sort_buckets_policy = sort_pass_policy<ExecutionPolicy, 4>;
+
+		const auto sort_buckets = task<sort_buckets_policy>(sort_buckets_impl<sort_buckets_policy>(blocks, bounds, offsets, layout, sorted_beg, ranked_comp));
+		sort_buckets(q, cl::sycl::range<1>{bucket_count * local_range[0]}, local_range);
+
+		// 4. the positions are dropped again
+		using drop_ranks_policy = sort_pass_policy<ExecutionPolicy, 5>;
+
+		std::invoke(transform<drop_ranks_policy>(sorted_beg, sorted_end, beg, [](const element_type &e) { return e.value; }), q);
+	};
+}
+
+template <typename K, typename V>
+struct key_value
+{
+	K key;
+	V value;
+};
+
+// every work item pairs a key with the value at the same position
+template <typename ExecutionPolicy, typename K, typename V>
+auto zip_impl(buffer_iterator<K, 1> keys_beg, buffer_iterator<K, 1> keys_end, buffer_iterator<V, 1> values_beg, buffer_iterator<key_value<K, V>, 1> out)
+{
+	using namespace traits;
+	using namespace cl::sycl::access;
+
+	using policy_type = strip_queue_t<ExecutionPolicy>;
+
+	auto values_end = values_beg;
+	values_end += cl::sycl::id<1>{distance(keys_beg, keys_end)[0]};
+
+	auto out_end = out;
+	out_end += cl::sycl::id<1>{distance(keys_beg, keys_end)[0]};
+
+	return [=](celerity::handler &cgh) {
+		auto keys_acc = get_access<policy_type, mode::read, one_to_one>(cgh, keys_beg, keys_end);
+		auto values_acc = get_access<policy_type, mode::read, one_to_one>(cgh, values_beg, values_end);
+		auto out_acc = get_access<policy_type, mode::discard_write, one_to_one>(cgh, out, out_end);
+
+		return [=](item_context<1, key_value<K, V>(K)> &ctx) {
+			out_acc[ctx.get_out()] = key_value<K, V>{keys_acc[ctx.get_in()], values_acc[ctx.get_in()]};
+		};
+	};
+}
+
+} // namespace detail
+
+// sorts [beg, end) in place, elements which are equal keep their order
+template <typename ExecutionPolicy, typename T, typename Compare = std::less<T>>
+void sort(ExecutionPolicy p, buffer_iterator<T, 1> beg, buffer_iterator<T, 1> end, const Compare &comp = {})
+{
+	std::invoke(detail::sort<ExecutionPolicy>(beg, end, comp), p.q);
+}
+
+template <typename ExecutionPolicy, typename T, typename Compare = std::less<T>>
+void sort(ExecutionPolicy p, buffer<T, 1> in, const Compare &comp = {})
+{
+	sort(p, begin(in), end(in), comp);
+}
+
+template <typename KernelName, typename T, typename Compare = std::less<T>>
+void sort(celerity::distr_queue q, buffer<T, 1> in, const Compare &comp = {})
+{
+	sort(distr<KernelName>(q), begin(in), end(in), comp);
+}
+
+// sorts [keys_beg, keys_end) in place and moves the values at the same positions along with their keys,
+// the values have to start at the same position of their buffer as the keys, std::invalid_argument is thrown otherwise
+template <typename ExecutionPolicy, typename K, typename V, typename Compare = std::less<K>>
+void sort_by_key(ExecutionPolicy p, buffer_iterator<K, 1> keys_beg, buffer_iterator<K, 1> keys_end, buffer_iterator<V, 1> values_beg, const Compare &comp = {})
+{
+	using pair_type = detail::key_value<K, V>;
+
+	if (*keys_beg != *values_beg)
+	{
+		throw std::invalid_argument("sort_by_key: keys and values have to start at the same position");
+	}
+
+	buffer<pair_type, 1> pairs{keys_beg.get_buffer().get_range()};
+
+	auto pairs_beg = celerity::begin(pairs);
+	pairs_beg += *keys_beg;
+
+	auto pairs_end = celerity::begin(pairs);
+	pairs_end += *keys_end;
+
+	using kernel_name = typename traits::policy_traits<traits::internal_launch_t<ExecutionPolicy>>::kernel_name;
+
+	using zip_policy = detail::named_distributed_execution_policy<nth_pass<kernel_name, 6>>;
+
+	const auto zip = detail::task<zip_policy>(detail::zip_impl<zip_policy>(keys_beg, keys_end, values_beg, pairs_beg));
+	zip(p.q, keys_beg, keys_end);
+
+	sort(p, pairs_beg, pairs_end, [comp](const pair_type &a, const pair_type &b) { return comp(a.key, b.key); });
+
+	transform(distr<nth_pass<kernel_name, 7>>(p.q), pairs_beg, pairs_end, keys_beg, [](const pair_type &kv) { return kv.key; });
+	transform(distr<nth_pass<kernel_name, 8>>(p.q), pairs_beg, pairs_end, values_beg, [](const pair_type &kv) { return kv.value; });
+}
+
+template <typename ExecutionPolicy, typename K, typename V, typename Compare = std::less<K>>
+void sort_by_key(ExecutionPolicy p, buffer<K, 1> keys, buffer<V, 1> values, const Compare &comp = {})
+{
+	sort_by_key(p, begin(keys), end(keys), begin(values), comp);
+}
+
+template <typename KernelName, typename K, typename V, typename Compare = std::less<K>>
+void sort_by_key(celerity::distr_queue q, buffer<K, 1> keys, buffer<V, 1> values, const Compare &comp = {})
+{
+	sort_by_key(distr<KernelName>(q), begin(keys), end(keys), begin(values), comp);
+}
+
+} // namespace celerity::algorithm
+
+#endif // SORT_H
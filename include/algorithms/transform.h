@@ -29,7 +29,7 @@ auto transform_impl(InIterator<T, Rank> beg, InIterator<T, Rank> end, OutIterato
         auto out_acc = get_access<policy_type, mode::discard_write, one_to_one>(cgh, out, out);
 
         return [=](item_context<Rank, U(T)> &ctx) {
-            out_acc[ctx.get_out()] = f(in_acc[ctx.get_in()]);
+            out_acc[ctx.get_out()] = f(load_view(in_acc, ctx.get_in()));
         };
     };
 }
@@ -49,7 +49,7 @@ auto transform_impl(InIterator<T, Rank> beg, InIterator<T, Rank> end, OutIterato
         auto out_acc = get_access<policy_type, mode::write, one_to_one>(cgh, out, out);
 
         return [=](item_context<Rank, U(T)> &ctx) {
-            out_acc[ctx.get_out()] = f(ctx.get_item(), in_acc[ctx.get_in()]);
+            out_acc[ctx.get_out()] = f(get_group_item(ctx), load_view(in_acc, ctx.get_in()));
         };
     };
 }
@@ -83,7 +83,7 @@ auto transform_impl(FirstInputIteratorType<T, Rank> beg,
         auto out_acc = get_access<policy_type, mode::discard_write, one_to_one>(cgh, out, out);
 
         return [=](item_context<Rank, V(T, U)> &ctx) {
-            out_acc[ctx.get_out()] = f(first_in_acc[ctx.template get_in<0>()], second_in_acc[ctx.template get_in<1>()]);
+            out_acc[ctx.get_out()] = f(load_view(first_in_acc, ctx.template get_in<0>()), load_view(second_in_acc, ctx.template get_in<1>()));
         };
     };
 }
@@ -116,7 +116,7 @@ auto transform_impl(FirstInputIteratorType<T, Rank> beg,
         auto out_acc = get_access<policy_type, mode::discard_write, one_to_one>(cgh, out, out);
 
         return [=](item_context<Rank, V(T, U)> &ctx) {
-            out_acc[ctx.get_out()] = f(ctx.get_item(), first_in_acc[ctx.template get_in<0>()], second_in_acc[ctx.template get_in<1>()]);
+            out_acc[ctx.get_out()] = f(get_group_item(ctx), load_view(first_in_acc, ctx.template get_in<0>()), load_view(second_in_acc, ctx.template get_in<1>()));
         };
     };
 }
@@ -218,10 +218,11 @@ auto transform(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<
     return std::invoke(detail::transform<ExecutionPolicy>(beg, end, beg2, out, f), p.q);
 }
 
-template <typename KernelName, typename F>
+// LocalExtents launch the stage in work groups of this size, statically typed views are then staged through local memory
+template <typename KernelName, size_t... LocalExtents, typename F>
 auto transform(const F &f)
 {
-    using execution_policy = detail::named_distributed_execution_policy<KernelName>;
+    using execution_policy = detail::named_distributed_execution_policy<KernelName, LocalExtents...>;
     return detail::transform<execution_policy>(f);
 }
 
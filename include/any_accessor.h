@@ -4,6 +4,7 @@
 #include "platform.h"
 #include "sycl.h"
 #include "celerity_accessor_traits.h"
+#include "tile.h"
 
 namespace celerity::algorithm::detail
 {
@@ -19,6 +20,31 @@ namespace celerity::algorithm::detail
         new (addr) T(o);
     }
 
+    // where the elements behind an any_accessor live, tiles of recomputed values are no SYCL accessor target
+    enum class accessor_source
+    {
+        global_buffer,
+        host_buffer,
+        tile
+    };
+
+    template <typename AccessorType>
+    constexpr accessor_source source_of()
+    {
+        if constexpr (traits::is_tile_accessor_v<AccessorType>)
+        {
+            return accessor_source::tile;
+        }
+        else if constexpr (traits::accessor_target_v<AccessorType> == cl::sycl::access::target::host_buffer)
+        {
+            return accessor_source::host_buffer;
+        }
+        else
+        {
+            return accessor_source::global_buffer;
+        }
+    }
+
     template <typename T, typename Storage = std::aligned_storage_t<128, 16>>
     class any_accessor
     {
@@ -29,7 +55,7 @@ namespace celerity::algorithm::detail
                   std::enable_if_t<std::is_same_v<T, traits::accessor_value_type_t<AccessorType>>, int> = 0>
         explicit any_accessor(const AccessorType &acc) noexcept : rank_(traits::accessor_rank_v<AccessorType>),
                                                                   mode_(traits::accessor_mode_v<AccessorType>),
-                                                                  target_(traits::accessor_target_v<AccessorType>)
+                                                                  source_(source_of<AccessorType>())
         {
             static_assert(sizeof(AccessorType) <= sizeof(storage_type));
             placement_copy_construct(&storage_, acc);
@@ -48,20 +74,20 @@ namespace celerity::algorithm::detail
         template <int Rank>
         decltype(auto) get(cl::sycl::id<Rank> id) const noexcept
         {
-            return apply<Rank>(mode_, target_, [=](auto &acc) { return acc[id]; });
+            return apply<Rank>(mode_, source_, [=](auto &acc) { return acc[id]; });
         }
 
     private:
         template <typename F>
         decltype(auto) apply(F f) const noexcept
         {
-            return apply(rank_, mode_, target_, f);
+            return apply(rank_, mode_, source_, f);
         }
 
         template <typename F>
         decltype(auto) apply(F f) noexcept
         {
-            return apply(rank_, mode_, target_, f);
+            return apply(rank_, mode_, source_, f);
         }
 
         template <typename AccessorType, typename F>
@@ -79,131 +105,158 @@ namespace celerity::algorithm::detail
         }
 
         template <int Rank, cl::sycl::access::mode Mode, typename F>
-        decltype(auto) apply(cl::sycl::access::target target, F f) const noexcept
+        decltype(auto) apply(accessor_source source, F f) const noexcept
         {
             using namespace cl::sycl::access;
 
-            switch (target)
+            switch (source)
             {
-            case target::global_buffer:
+            case accessor_source::global_buffer:
                 return apply<device_accessor<T, Rank, Mode, target::global_buffer>>(f);
+            case accessor_source::tile:
+                return apply<tile_accessor<T, Rank>>(f);
 #ifndef CELERITY_STD_COMPILING_FOR_DEVICE
-            case target::host_buffer:
+            case accessor_source::host_buffer:
                 return apply<host_accessor<T, Rank, Mode>>(f);
 #endif
             default:
-                on_error("any_accessor", "invalid access target");
+                on_error("any_accessor", "invalid accessor source");
             }
 
             return apply<device_accessor<T, Rank, Mode, target::global_buffer>>(f);
         }
 
         template <int Rank, cl::sycl::access::mode Mode, typename F>
-        decltype(auto) apply(cl::sycl::access::target target, F f) noexcept
+        decltype(auto) apply(accessor_source source, F f) noexcept
         {
             using namespace cl::sycl::access;
 
-            switch (target)
+            switch (source)
             {
-            case target::global_buffer:
+            case accessor_source::global_buffer:
                 return apply<device_accessor<T, Rank, Mode, target::global_buffer>>(f);
+            case accessor_source::tile:
+                return apply<tile_accessor<T, Rank>>(f);
 #ifndef CELERITY_STD_COMPILING_FOR_DEVICE
-            case target::host_buffer:
+            case accessor_source::host_buffer:
                 return apply<host_accessor<T, Rank, Mode>>(f);
 #endif
             default:
-                on_error("any_accessor", "invalid access target");
+                on_error("any_accessor", "invalid accessor source");
             }
 
             return apply<device_accessor<T, Rank, Mode, target::global_buffer>>(f);
         }
 
         template <int Rank, typename F>
-        decltype(auto) apply(cl::sycl::access::mode mode, cl::sycl::access::target target, F f) const noexcept
+        decltype(auto) apply(cl::sycl::access::mode mode, accessor_source source, F f) const noexcept
         {
             using namespace cl::sycl::access;
 
             switch (mode)
             {
             case mode::read:
-                return apply<Rank, mode::read>(target, f);
+                return apply<Rank, mode::read>(source, f);
             case mode::write:
-                return apply<Rank, mode::write>(target, f);
+                return apply<Rank, mode::write>(source, f);
             case mode::read_write:
-                return apply<Rank, mode::read_write>(target, f);
+                return apply<Rank, mode::read_write>(source, f);
             default:
                 on_error("any_accessor", "invalid access mode");
             }
 
-            return apply<Rank, mode::read_write>(target, f);
+            return apply<Rank, mode::read_write>(source, f);
         }
 
         template <int Rank, typename F>
-        decltype(auto) apply(cl::sycl::access::mode mode, cl::sycl::access::target target, F f) noexcept
+        decltype(auto) apply(cl::sycl::access::mode mode, accessor_source source, F f) noexcept
         {
             using namespace cl::sycl::access;
 
             switch (mode)
             {
             case mode::read:
-                return apply<Rank, mode::read>(target, f);
+                return apply<Rank, mode::read>(source, f);
             case mode::write:
-                return apply<Rank, mode::write>(target, f);
+                return apply<Rank, mode::write>(source, f);
             case mode::read_write:
-                return apply<Rank, mode::read_write>(target, f);
+                return apply<Rank, mode::read_write>(source, f);
             default:
                 on_error("any_accessor", "invalid access mode");
             }
 
-            return apply<Rank, mode::read_write>(target, f);
+            return apply<Rank, mode::read_write>(source, f);
         }
 
         template <typename F>
-        decltype(auto) apply(int rank, cl::sycl::access::mode mode, cl::sycl::access::target target, F f) const noexcept
+        decltype(auto) apply(int rank, cl::sycl::access::mode mode, accessor_source source, F f) const noexcept
         {
             using namespace cl::sycl::access;
 
             switch (rank)
             {
             case 1:
-                return apply<1>(mode, target, f);
+                return apply<1>(mode, source, f);
             case 2:
-                return apply<2>(mode, target, f);
+                return apply<2>(mode, source, f);
             case 3:
-                return apply<3>(mode, target, f);
+                return apply<3>(mode, source, f);
             default:
                 on_error("any_accessor", "invalid rank");
             }
 
-            return apply<1>(mode, target, f);
+            return apply<1>(mode, source, f);
         }
 
         template <typename F>
-        decltype(auto) apply(int rank, cl::sycl::access::mode mode, cl::sycl::access::target target, F f) noexcept
+        decltype(auto) apply(int rank, cl::sycl::access::mode mode, accessor_source source, F f) noexcept
         {
             using namespace cl::sycl::access;
 
             switch (rank)
             {
             case 1:
-                return apply<1>(mode, target, f);
+                return apply<1>(mode, source, f);
             case 2:
-                return apply<2>(mode, target, f);
+                return apply<2>(mode, source, f);
             case 3:
-                return apply<3>(mode, target, f);
+                return apply<3>(mode, source, f);
             default:
                 on_error("any_accessor", "invalid rank");
             }
 
-            return apply<1>(mode, target, f);
+            return apply<1>(mode, source, f);
         }
 
         const long rank_;
         const cl::sycl::access::mode mode_;
-        const cl::sycl::access::target target_;
+        const accessor_source source_;
         storage_type storage_;
     };
 
 } // namespace celerity::algorithm::detail
 
+namespace celerity::algorithm::traits
+{
+    template <typename T>
+    struct is_any_accessor : std::false_type
+    {
+    };
+
+    template <typename T, typename Storage>
+    struct is_any_accessor<detail::any_accessor<T, Storage>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool is_any_accessor_v = is_any_accessor<T>::value;
+
+    template <typename T, typename Storage>
+    struct accessor_value_type<detail::any_accessor<T, Storage>>
+    {
+        using type = T;
+    };
+
+} // namespace celerity::algorithm::traits
+
 #endif
\ No newline at end of file
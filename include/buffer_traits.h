@@ -20,6 +20,18 @@ struct buffer_traits
     using all = all<ElementType, Rank>;
 
     using item = cl::sycl::item<Rank>;
+
+    // views reading the buffer straight from a device accessor instead of through any_accessor,
+    // only usable for inputs of distributed tasks which are read from a buffer
+    using device_accessor = detail::device_accessor<ElementType, Rank, cl::sycl::access::mode::read, cl::sycl::access::target::global_buffer>;
+
+    template <int Dim>
+    using device_slice = basic_slice<device_accessor, Dim>;
+
+    template <size_t... Extents>
+    using device_chunk = basic_chunk<device_accessor, Extents...>;
+
+    using device_all = basic_all<device_accessor, Rank>;
 };
 
 } // namespace celerity::algorithm::traits
@@ -0,0 +1,80 @@
+#ifndef COARSEN_H
+#define COARSEN_H
+
+#include "celerity_helper.h"
+#include "sycl.h"
+#include "element_launch.h"
+
+#include <algorithm>
+
+namespace celerity::algorithm
+{
+
+    namespace detail
+    {
+
+        // work items of a task coarsened by factor along the last dimension evaluate the elements of
+        // a box of factor elements of [offset, offset + range) which starts factor times their id
+        template <int Rank>
+        class coarsened_launch_scope : public element_launch_scope<Rank>
+        {
+        public:
+            coarsened_launch_scope(size_t factor, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+                : element_launch_scope<Rank>(offset, factor_range(factor), offset, range) {}
+
+        private:
+            static cl::sycl::range<Rank> factor_range(size_t factor)
+            {
+                cl::sycl::range<Rank> r{};
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    r[i] = 1;
+                }
+
+                r[Rank - 1] = factor;
+                return r;
+            }
+        };
+
+        // number of work items launched for range if every work item processes factor elements along the last dimension
+        template <int Rank>
+        cl::sycl::range<Rank> coarsened_range(cl::sycl::range<Rank> range, size_t factor)
+        {
+            range[Rank - 1] = (range[Rank - 1] + factor - 1) / factor;
+            return range;
+        }
+
+        // invokes f for the Factor contiguous elements of a work item along the last dimension, one element after another,
+        // work items with all Factor elements in range loop a constant number of times, the last work item of a row handles the tail
+        template <size_t Factor, int Rank, typename F>
+        void for_each_element(cl::sycl::item<Rank> item, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range, const F &f)
+        {
+            auto id = item.get_id();
+
+            const auto first = offset[Rank - 1] + (id[Rank - 1] - offset[Rank - 1]) * Factor;
+            const auto last = offset[Rank - 1] + range[Rank - 1];
+
+            if (first + Factor <= last)
+            {
+                for (size_t i = 0; i < Factor; ++i)
+                {
+                    id[Rank - 1] = first + i;
+                    f(cl::sycl::detail::make_item(id, range, offset));
+                }
+            }
+            else
+            {
+                for (auto i = first; i < last; ++i)
+                {
+                    id[Rank - 1] = i;
+                    f(cl::sycl::detail::make_item(id, range, offset));
+                }
+            }
+        }
+
+    } // namespace detail
+
+} // namespace celerity::algorithm
+
+#endif // COARSEN_H
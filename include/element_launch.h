@@ -0,0 +1,121 @@
+#ifndef ELEMENT_LAUNCH_H
+#define ELEMENT_LAUNCH_H
+
+#include "celerity_helper.h"
+#include "sycl.h"
+
+#include <algorithm>
+#include <array>
+
+namespace celerity::algorithm
+{
+
+    namespace detail
+    {
+
+        // relation between the work items of the task whose command group is currently built and the elements
+        // its kernels are evaluated for, every work item evaluates the elements of a box of factor elements,
+        // clamped to [offset, offset + range), which starts at offset + (item - launch_offset) * factor,
+        // it is only set (rank != 0) while the command group of a task whose work items do not map one to one to elements is built
+        struct element_launch
+        {
+            int rank = 0;
+            std::array<size_t, 3> launch_offset{};
+            std::array<size_t, 3> factor{};
+            std::array<size_t, 3> offset{};
+            std::array<size_t, 3> range{};
+        };
+
+        inline thread_local element_launch current_element_launch{};
+
+        template <int Rank>
+        class element_launch_scope
+        {
+        public:
+            // work items evaluate the elements of factor-sized boxes of [offset, offset + range)
+            element_launch_scope(cl::sycl::id<Rank> launch_offset, cl::sycl::range<Rank> factor, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+                : previous_(current_element_launch)
+            {
+                current_element_launch.rank = Rank;
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    current_element_launch.launch_offset[i] = launch_offset[i];
+                    current_element_launch.factor[i] = factor[i];
+                    current_element_launch.offset[i] = offset[i];
+                    current_element_launch.range[i] = range[i];
+                }
+            }
+
+            // work items evaluate the element they are launched for, the launch may extend past the end of [offset, offset + range)
+            element_launch_scope(cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+                : element_launch_scope(offset, unit_range(), offset, range) {}
+
+            ~element_launch_scope()
+            {
+                current_element_launch = previous_;
+            }
+
+            element_launch_scope(const element_launch_scope &) = delete;
+            element_launch_scope &operator=(const element_launch_scope &) = delete;
+
+        private:
+            element_launch previous_;
+
+            static cl::sycl::range<Rank> unit_range()
+            {
+                cl::sycl::range<Rank> r{};
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    r[i] = 1;
+                }
+
+                return r;
+            }
+        };
+
+        template <int Rank>
+        bool has_element_launch()
+        {
+            return current_element_launch.rank == Rank;
+        }
+
+        // maps a chunk of work items to the chunk of elements they evaluate before applying the range mapper
+        template <int Rank, typename RangeMapper>
+        struct element_range_mapper
+        {
+            RangeMapper mapper;
+            element_launch launch = current_element_launch;
+
+            celerity::subrange<Rank> operator()(celerity::chunk<Rank> chnk) const
+            {
+                if (launch.rank == Rank)
+                {
+                    for (auto i = 0; i < Rank; ++i)
+                    {
+                        const auto end = launch.offset[i] + launch.range[i];
+                        const auto first = std::min(launch.offset[i] + (chnk.offset[i] - launch.launch_offset[i]) * launch.factor[i], end);
+                        const auto last = std::min(first + chnk.range[i] * launch.factor[i], end);
+
+                        chnk.offset[i] = first;
+                        chnk.range[i] = last - first;
+                        chnk.global_size[i] = launch.range[i];
+                    }
+                }
+
+                return mapper(chnk);
+            }
+        };
+
+        template <int Rank, typename RangeMapper>
+        auto map_to_elements(RangeMapper mapper)
+        {
+            return element_range_mapper<Rank, RangeMapper>{mapper};
+        }
+
+    } // namespace detail
+
+} // namespace celerity::algorithm
+
+#endif // ELEMENT_LAUNCH_H
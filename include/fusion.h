@@ -7,9 +7,11 @@
 #include "packaged_tasks/packaged_generate.h"
 #include "packaged_tasks/packaged_transform.h"
 #include "packaged_tasks/packaged_zip.h"
+#include "packaged_tasks/packaged_reduce.h"
 
 #include "task.h"
 #include "t_joint.h"
+#include "tile.h"
 
 #include "require.h"
 
@@ -25,11 +27,16 @@ auto fuse(const sequence<Actions...> &s);
 namespace fuse_impl
 {
 
+//
+//
+// [a] is evaluated for every element of the chunk around the item of b
+//   \
+//    +----{b} reads a tile instead of a chunk of a buffer
 template <typename ExecutionPolicyA, typename KernelA, typename ExecutionPolicyB, typename KernelB>
-auto fuse(task_t<ExecutionPolicyA, KernelA> a, task_t<ExecutionPolicyB, KernelB> b)
+auto fuse_tiled(task_t<ExecutionPolicyA, KernelA> a, task_t<ExecutionPolicyB, KernelB> b)
 {
-    using new_execution_policy = named_distributed_execution_policy<
-        indexed_kernel_name_t<fused<ExecutionPolicyA, ExecutionPolicyB>>>;
+    using new_execution_policy = traits::fused_policy_t<
+        indexed_kernel_name_t<fused<ExecutionPolicyA, ExecutionPolicyB>>, ExecutionPolicyA, ExecutionPolicyB>;
 
     using kernel_a_type = std::invoke_result_t<decltype(a.get_sequence()), handler &>;
     using context_a_type = std::decay_t<traits::arg_type_t<kernel_a_type, 0>>;
@@ -38,18 +45,33 @@ auto fuse(task_t<ExecutionPolicyA, KernelA> a, task_t<ExecutionPolicyB, KernelB>
     using context_b_type = std::decay_t<traits::arg_type_t<kernel_b_type, 0>>;
 
     using combined_context_type = combined_context_t<context_a_type, context_b_type>;
+    using tile_type = first_input_t<context_b_type>;
+
+    constexpr auto rank = context_b_type::rank;
+
+    auto seq_a = a.get_sequence();
+    auto seq_b = b.get_sequence();
 
     auto f = [=](handler &cgh) {
-        const auto kernels_a = sequence(std::invoke(a.get_sequence(), cgh));
-        const auto kernels_b = sequence(std::invoke(b.get_sequence(), cgh));
+        // a reads the halo of the chunks of b as well
+        const auto kernels_a = [&]() {
+            const tile_halo_scope<tile_type> scope{};
+            return sequence(std::invoke(seq_a, cgh));
+        }();
+
+        const auto kernels_b = sequence(std::invoke(seq_b, cgh));
 
         return [=](combined_context_type &ctx) {
-            context_a_type ctx_a(ctx.get_item());
-            ctx_a.copy_in(ctx);
+            context_b_type ctx_b{ctx.get_item(), ctx.get_group()};
 
-            kernels_a(ctx_a);
+            get_first_in(ctx_b).get().fill(ctx.get_item(), [&](cl::sycl::item<rank> item) {
+                // the halo is recomputed per work item and skips ids outside of the range, so a must not synchronize with its work group
+                context_a_type ctx_a{item};
+                kernels_a(ctx_a);
+
+                return ctx_a.get_out().get();
+            });
 
-            context_b_type ctx_b{ctx_a, ctx};
             kernels_b(ctx_b);
 
             ctx.copy_out(ctx_b);
@@ -59,6 +81,47 @@ auto fuse(task_t<ExecutionPolicyA, KernelA> a, task_t<ExecutionPolicyB, KernelB>
     return task<new_execution_policy>(f);
 }
 
+template <typename ExecutionPolicyA, typename KernelA, typename ExecutionPolicyB, typename KernelB>
+auto fuse(task_t<ExecutionPolicyA, KernelA> a, task_t<ExecutionPolicyB, KernelB> b)
+{
+    using new_execution_policy = traits::fused_policy_t<
+        indexed_kernel_name_t<fused<ExecutionPolicyA, ExecutionPolicyB>>, ExecutionPolicyA, ExecutionPolicyB>;
+
+    using kernel_a_type = std::invoke_result_t<decltype(a.get_sequence()), handler &>;
+    using context_a_type = std::decay_t<traits::arg_type_t<kernel_a_type, 0>>;
+
+    using kernel_b_type = std::invoke_result_t<decltype(b.get_sequence()), handler &>;
+    using context_b_type = std::decay_t<traits::arg_type_t<kernel_b_type, 0>>;
+
+    using combined_context_type = combined_context_t<context_a_type, context_b_type>;
+
+    if constexpr (traits::is_tile_v<first_input_t<context_b_type>>)
+    {
+        return fuse_tiled(a, b);
+    }
+    else
+    {
+        auto f = [=](handler &cgh) {
+            const auto kernels_a = sequence(std::invoke(a.get_sequence(), cgh));
+            const auto kernels_b = sequence(std::invoke(b.get_sequence(), cgh));
+
+            return [=](combined_context_type &ctx) {
+                context_a_type ctx_a(ctx.get_item(), ctx.get_group());
+                ctx_a.copy_in(ctx);
+
+                kernels_a(ctx_a);
+
+                context_b_type ctx_b{ctx_a, ctx};
+                kernels_b(ctx_b);
+
+                ctx.copy_out(ctx_b);
+            };
+        };
+
+        return task<new_execution_policy>(f);
+    }
+}
+
 //
 //
 // [a] computes first input of c
@@ -73,8 +136,8 @@ auto fuse(task_t<ExecutionPolicyA, KernelA> a,
           task_t<ExecutionPolicyB, KernelB> b,
           task_t<ExecutionPolicyC, KernelC> c)
 {
-    using new_execution_policy = named_distributed_execution_policy<
-        indexed_kernel_name_t<fused<fused<ExecutionPolicyA, ExecutionPolicyB>, ExecutionPolicyC>>>;
+    using new_execution_policy = traits::fused_policy_t<
+        indexed_kernel_name_t<fused<fused<ExecutionPolicyA, ExecutionPolicyB>, ExecutionPolicyC>>, ExecutionPolicyA, ExecutionPolicyB, ExecutionPolicyC>;
 
     using kernel_a_type = std::invoke_result_t<decltype(a.get_sequence()), handler &>;
     using context_a_type = std::decay_t<traits::arg_type_t<kernel_a_type, 0>>;
@@ -97,11 +160,11 @@ auto fuse(task_t<ExecutionPolicyA, KernelA> a,
         const auto kernels_c = sequence(std::invoke(seq_c, cgh));
 
         return [=](combined_context_type &ctx) {
-            context_a_type ctx_a{ctx.get_item()};
+            context_a_type ctx_a{ctx.get_item(), ctx.get_group()};
             ctx_a.copy_in(ctx);
             kernels_a(ctx_a);
 
-            context_b_type ctx_b{ctx.get_item()};
+            context_b_type ctx_b{ctx.get_item(), ctx.get_group()};
             kernels_b(ctx_b);
 
             context_c_type ctx_c{ctx_a, ctx_b};
@@ -126,8 +189,8 @@ template <typename ExecutionPolicyB, typename KernelB,
 auto fuse_right(task_t<ExecutionPolicyB, KernelB> b,
                 task_t<ExecutionPolicyC, KernelC> c)
 {
-    using new_execution_policy = named_distributed_execution_policy<
-        indexed_kernel_name_t<fused<ExecutionPolicyB, ExecutionPolicyC>>>;
+    using new_execution_policy = traits::fused_policy_t<
+        indexed_kernel_name_t<fused<ExecutionPolicyB, ExecutionPolicyC>>, ExecutionPolicyB, ExecutionPolicyC>;
 
     using kernel_b_type = std::invoke_result_t<decltype(b.get_sequence()), handler &>;
     using context_b_type = std::decay_t<traits::arg_type_t<kernel_b_type, 0>>;
@@ -143,7 +206,7 @@ auto fuse_right(task_t<ExecutionPolicyB, KernelB> b,
         const auto kernels_c = sequence(std::invoke(seq_c, cgh));
 
         return [=](context_c_type &ctx_c) {
-            context_b_type ctx_b{ctx_c.get_item()};
+            context_b_type ctx_b{ctx_c.get_item(), ctx_c.get_group()};
             kernels_b(ctx_b);
 
             ctx_c.template get_in<1>() = ctx_b.get_out();
@@ -157,11 +220,12 @@ auto fuse_right(task_t<ExecutionPolicyB, KernelB> b,
 template <typename T, typename U,
           require<traits::are_fusable_v<T, U>,
                   traits::computation_type_of_v<T, computation_type::transform>,
+                  !traits::computation_type_of_v<U, computation_type::reduce>,
                   !traits::is_t_joint_v<U>,
                   !traits::is_t_joint_v<T>> = yes>
 auto fuse(T lhs, U rhs)
 {
-    return package_transform<access_type::one_to_one>(fuse(lhs.get_task(), rhs.get_task()),
+    return package_transform<traits::access_type_v<T>>(fuse(lhs.get_task(), rhs.get_task()),
                                                       lhs.get_in_beg(),
                                                       lhs.get_in_end(),
                                                       rhs.get_out_beg());
@@ -177,6 +241,7 @@ auto fuse(T lhs, U rhs)
 template <typename T, typename U,
           require<traits::are_fusable_v<T, U>,
                   traits::computation_type_of_v<T, computation_type::generate>,
+                  !traits::computation_type_of_v<U, computation_type::reduce>,
                   !traits::is_t_joint_v<U>,
                   !traits::is_t_joint_v<T>> = yes>
 auto fuse(T lhs, U rhs)
@@ -192,6 +257,7 @@ auto fuse(T lhs, U rhs)
 template <typename T, typename U,
           require<traits::are_fusable_v<T, U>,
                   traits::computation_type_of_v<T, computation_type::zip>,
+                  !traits::computation_type_of_v<U, computation_type::reduce>,
                   !traits::is_t_joint_v<U>,
                   !traits::is_t_joint_v<T>> = yes>
 auto fuse(T lhs, U rhs)
@@ -205,6 +271,32 @@ auto fuse(T lhs, U rhs)
                                                                         rhs.get_out_beg());
 }
 
+template <typename T, typename U,
+          require<traits::are_fusable_v<T, U>,
+                  traits::computation_type_of_v<U, computation_type::reduce>,
+                  !traits::is_t_joint_v<U>,
+                  !traits::is_t_joint_v<T>> = yes>
+auto fuse(T lhs, U rhs)
+{
+    using output_value_type = typename traits::packaged_task_traits<U>::output_value_type;
+
+    // the elements are computed by the producing kernels right where they are folded
+    if constexpr (traits::computation_type_of_v<T, computation_type::generate>)
+    {
+        return package_reduce<output_value_type>(fuse(lhs.get_task(), rhs.get_task()),
+                                                 rhs.get_reduction(),
+                                                 rhs.get_in_beg(),
+                                                 rhs.get_in_end());
+    }
+    else
+    {
+        return package_reduce<output_value_type>(fuse(lhs.get_task(), rhs.get_task()),
+                                                 rhs.get_reduction(),
+                                                 lhs.get_in_beg(),
+                                                 lhs.get_in_end());
+    }
+}
+
 template <typename T,
           require<traits::is_t_joint_v<T>> = yes>
 auto fuse(T joint)
@@ -277,10 +369,10 @@ auto fuse(T joint)
             }
         }
     }
-    // non-fusable
+    // non-fusable, but the secondary sequence may itself be a tree of fusable tasks
     else
     {
-        return joint;
+        return make_t_joint(joint.get_task(), fuse(joint.get_secondary()));
     }
 }
 
@@ -316,13 +408,28 @@ template <typename T, typename U,
                   !traits::is_t_joint_v<U>> = yes>
 auto fuse(T lhs, U rhs)
 {
-    if constexpr (traits::are_fusable_v<decltype(lhs.get_task()), U>)
+    // fuse t_joint internally first, its secondary may collapse into its task
+    auto fused_lhs = fuse(lhs);
+    using fused_lhs_type = decltype(fused_lhs);
+
+    if constexpr (!traits::is_t_joint_v<fused_lhs_type>)
     {
-        return make_t_joint(fuse(lhs.get_task(), rhs), lhs.get_secondary());
+        if constexpr (traits::are_fusable_v<fused_lhs_type, U>)
+        {
+            return fuse(fused_lhs, rhs);
+        }
+        else
+        {
+            return sequence(fused_lhs, rhs);
+        }
+    }
+    else if constexpr (traits::are_fusable_v<decltype(fused_lhs.get_task()), U>)
+    {
+        return make_t_joint(fuse(fused_lhs.get_task(), rhs), fused_lhs.get_secondary());
     }
     else
     {
-        return sequence(lhs, rhs);
+        return sequence(fused_lhs, rhs);
     }
 }
 
@@ -0,0 +1,228 @@
+#ifndef HOST_THREADS_H
+#define HOST_THREADS_H
+
+#include "sycl.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace celerity::algorithm::detail
+{
+
+    // host loops are only split into partitions of at least this many iterations,
+    // smaller loops do not amortize handing a partition to another thread
+    inline constexpr size_t min_host_partition = 1 << 14;
+
+    // iterations of unknown cost are handed out to the host threads in blocks of this many iterations
+    inline constexpr size_t host_block_size = 1 << 10;
+
+    inline size_t host_thread_count()
+    {
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    // the threads all parallel host loops of the process run on, they are started on first use and wait for work in between,
+    // together with the thread calling run there are host_thread_count() threads
+    class host_thread_pool
+    {
+    public:
+        static host_thread_pool &get()
+        {
+            static host_thread_pool pool{host_thread_count() - 1};
+            return pool;
+        }
+
+        host_thread_pool(const host_thread_pool &) = delete;
+        host_thread_pool &operator=(const host_thread_pool &) = delete;
+
+        ~host_thread_pool()
+        {
+            {
+                std::lock_guard lock{mutex_};
+                stop_ = true;
+            }
+
+            cv_.notify_all();
+
+            for (auto &w : workers_)
+            {
+                w.join();
+            }
+        }
+
+        size_t size() const { return workers_.size() + 1; }
+
+        // invokes f(t) for every t of [0, count), f(0) on the calling thread, and returns once all of them are done,
+        // a caller waiting for its invocations runs queued ones itself, so loops nested in other loops cannot starve the pool
+        template <typename F>
+        void run(size_t count, const F &f)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            std::atomic<size_t> pending{count - 1};
+
+            {
+                std::lock_guard lock{mutex_};
+
+                for (size_t t = 1; t < count; ++t)
+                {
+                    queue_.emplace_back([this, &f, &pending, t]() {
+                        f(t);
+
+                        if (--pending == 0)
+                        {
+                            std::lock_guard done_lock{mutex_};
+                            cv_.notify_all();
+                        }
+                    });
+                }
+            }
+
+            cv_.notify_all();
+
+            f(size_t{0});
+
+            while (pending > 0)
+            {
+                if (!run_queued())
+                {
+                    std::unique_lock lock{mutex_};
+                    cv_.wait(lock, [&]() { return pending == 0 || !queue_.empty(); });
+                }
+            }
+        }
+
+    private:
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> queue_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stop_ = false;
+
+        explicit host_thread_pool(size_t workers)
+        {
+            workers_.reserve(workers);
+
+            for (size_t w = 0; w < workers; ++w)
+            {
+                workers_.emplace_back([this]() {
+                    for (;;)
+                    {
+                        std::unique_lock lock{mutex_};
+                        cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+
+                        if (queue_.empty())
+                        {
+                            return;
+                        }
+
+                        auto task = std::move(queue_.front());
+                        queue_.pop_front();
+                        lock.unlock();
+
+                        task();
+                    }
+                });
+            }
+        }
+
+        bool run_queued()
+        {
+            std::function<void()> task;
+
+            {
+                std::lock_guard lock{mutex_};
+
+                if (queue_.empty())
+                {
+                    return false;
+                }
+
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+
+            task();
+            return true;
+        }
+    };
+
+    // invokes f(first, last) for contiguous partitions of [0, count) on the host threads,
+    // the calling thread processes the first partition and returns once all partitions are done
+    template <typename F>
+    void parallel_host_for(size_t count, const F &f)
+    {
+        auto &pool = host_thread_pool::get();
+
+        const auto partitions = std::max<size_t>(std::min(pool.size(), count / min_host_partition), 1);
+        const auto partition_size = (count + partitions - 1) / partitions;
+
+        pool.run(partitions, [&](size_t p) {
+            const auto first = std::min(p * partition_size, count);
+            const auto last = std::min(first + partition_size, count);
+
+            f(first, last);
+        });
+    }
+
+    // the id of the linear_id-th element of range in row-major order
+    template <int Rank>
+    cl::sycl::id<Rank> row_major_id(size_t linear_id, cl::sycl::range<Rank> range)
+    {
+        cl::sycl::id<Rank> id{};
+
+        for (auto d = Rank - 1; d >= 0; --d)
+        {
+            id[d] = linear_id % range[d];
+            linear_id /= range[d];
+        }
+
+        return id;
+    }
+
+    // invokes f(first, last) for blocks of block_size iterations of [0, count), every host thread takes the next
+    // unprocessed block once it is done with its previous one, so iterations of uneven cost are balanced between the threads
+    template <typename F>
+    void dynamic_host_for(size_t count, size_t block_size, const F &f)
+    {
+        auto &pool = host_thread_pool::get();
+
+        const auto blocks = (count + block_size - 1) / block_size;
+        const auto thread_count = std::max<size_t>(std::min(pool.size(), blocks), 1);
+
+        std::atomic<size_t> next_block{0};
+
+        pool.run(thread_count, [&](size_t) {
+            for (auto b = next_block++; b < blocks; b = next_block++)
+            {
+                f(b * block_size, std::min((b + 1) * block_size, count));
+            }
+        });
+    }
+
+    // invokes f(item) for every item of [offset, offset + range) on the host threads
+    template <int Rank, typename F>
+    void parallel_for_each_index(cl::sycl::range<Rank> range, cl::sycl::id<Rank> offset, const F &f)
+    {
+        dynamic_host_for(range.size(), host_block_size, [&](size_t first, size_t last) {
+            auto id = row_major_id(first, range);
+
+            for (auto i = first; i < last; ++i, id = next(id, range))
+            {
+                f(cl::sycl::detail::make_item(id + offset, range, offset));
+            }
+        });
+    }
+
+} // namespace celerity::algorithm::detail
+
+#endif // HOST_THREADS_H
@@ -2,6 +2,7 @@
 #define ITEM_CONTEXT_H
 
 #include "celerity_helper.h"
+#include "work_group.h"
 
 namespace celerity::algorithm
 {
@@ -14,11 +15,13 @@ class item_shared_data
 {
 public:
     item_shared_data(const item_shared_data &rhs) = default;
-    item_shared_data(T &data, cl::sycl::item<Rank> item)
-        : data_(data), item_(item) {}
+    item_shared_data(T &data, cl::sycl::item<Rank> item, const work_group<Rank> *group = nullptr)
+        : data_(data), item_(item), group_(group) {}
 
     T &get() const { return data_; }
 
+    const work_group<Rank> *get_group() const { return group_; }
+
     operator cl::sycl::item<Rank>()
     {
         return item_;
@@ -41,6 +44,7 @@ public:
 private:
     T &data_;
     cl::sycl::item<Rank> item_;
+    const work_group<Rank> *group_;
 };
 
 template <int Rank, typename ContextType>
@@ -61,8 +65,8 @@ public:
     item_context(item_context &&) = delete;
     item_context &operator=(item_context &&) = delete;
 
-    explicit item_context(cl::sycl::item<Rank> item)
-        : item_(item) {}
+    explicit item_context(cl::sycl::item<Rank> item, const work_group<Rank> *group = nullptr)
+        : item_(item), group_(group) {}
 
     template <typename U>
     void copy_in(item_context<Rank, U()> &)
@@ -75,13 +79,16 @@ public:
         get_out() = other.get_out();
     }
 
-    item_shared_data<Rank, OutType> get_out() { return {out_, item_}; }
+    item_shared_data<Rank, OutType> get_out() { return {out_, item_, group_}; }
 
     cl::sycl::item<Rank> get_item() const { return item_; }
 
+    const work_group<Rank> *get_group() const { return group_; }
+
 private:
     OutType out_;
     cl::sycl::item<Rank> item_;
+    const work_group<Rank> *group_;
 };
 
 template <int Rank, typename InType>
@@ -99,12 +106,12 @@ public:
     item_context(item_context &&) = delete;
     item_context &operator=(item_context &&) = delete;
 
-    explicit item_context(cl::sycl::item<Rank> item)
-        : item_(item) {}
+    explicit item_context(cl::sycl::item<Rank> item, const work_group<Rank> *group = nullptr)
+        : item_(item), group_(group) {}
 
     template <typename ItemContext>
     explicit item_context(ItemContext &ctx)
-        : item_(ctx.get_item())
+        : item_(ctx.get_item()), group_(ctx.get_group())
     {
         static_assert(std::is_convertible_v<std::decay_t<decltype(get_in())>, decltype(ctx.get_out())>);
         get_in() = ctx.get_out();
@@ -127,13 +134,16 @@ public:
     {
     }
 
-    item_shared_data<Rank, InType> get_in() { return {in_, item_}; }
+    item_shared_data<Rank, InType> get_in() { return {in_, item_, group_}; }
 
     cl::sycl::item<Rank> get_item() const { return item_; }
 
+    const work_group<Rank> *get_group() const { return group_; }
+
 private:
     InType in_;
     cl::sycl::item<Rank> item_;
+    const work_group<Rank> *group_;
 };
 
 template <int Rank, typename OutType, typename InType>
@@ -151,12 +161,12 @@ public:
     item_context(item_context &&) = delete;
     item_context &operator=(item_context &&) = delete;
 
-    explicit item_context(cl::sycl::item<Rank> item)
-        : item_(item) {}
+    explicit item_context(cl::sycl::item<Rank> item, const work_group<Rank> *group = nullptr)
+        : item_(item), group_(group) {}
 
     template <typename ItemContext>
     explicit item_context(ItemContext &ctx)
-        : item_(ctx.get_item())
+        : item_(ctx.get_item()), group_(ctx.get_group())
     {
         static_assert(std::is_convertible_v<std::decay_t<decltype(get_in())>, decltype(ctx.get_out())>);
         get_in() = ctx.get_out();
@@ -180,15 +190,18 @@ public:
         get_out() = other.get_out();
     }
 
-    item_shared_data<Rank, InType> get_in() { return {in_, item_}; }
-    item_shared_data<Rank, OutType> get_out() { return {out_, item_}; }
+    item_shared_data<Rank, InType> get_in() { return {in_, item_, group_}; }
+    item_shared_data<Rank, OutType> get_out() { return {out_, item_, group_}; }
 
     cl::sycl::item<Rank> get_item() const { return item_; }
 
+    const work_group<Rank> *get_group() const { return group_; }
+
 private:
     InType in_;
     OutType out_;
     cl::sycl::item<Rank> item_;
+    const work_group<Rank> *group_;
 };
 
 template <int Rank, typename OutType, typename T, typename... Ts>
@@ -207,8 +220,8 @@ public:
     item_context(item_context &&) = delete;
     item_context &operator=(item_context &&) = delete;
 
-    explicit item_context(cl::sycl::item<Rank> item)
-        : item_(item) {}
+    explicit item_context(cl::sycl::item<Rank> item, const work_group<Rank> *group = nullptr)
+        : item_(item), group_(group) {}
 
     // template<typename ItemContext>
     // explicit item_context(ItemContextA a)
@@ -220,7 +233,7 @@ public:
 
     template <typename ItemContextA, typename ItemContextB>
     item_context(ItemContextA &a, ItemContextB &b)
-        : item_(a.get_item())
+        : item_(a.get_item()), group_(a.get_group())
     {
         static_assert(std::is_convertible_v<std::decay_t<decltype(get_in<0>())>, decltype(a.get_out())>);
         static_assert(std::is_convertible_v<std::decay_t<decltype(get_in<1>())>, decltype(b.get_out())>);
@@ -235,7 +248,7 @@ public:
     auto get_in()
     {
         static_assert(Index < std::tuple_size_v<decltype(in_)>);
-        return item_shared_data{std::get<Index>(in_), item_};
+        return item_shared_data{std::get<Index>(in_), item_, group_};
     }
 
     template <typename U>
@@ -260,14 +273,17 @@ public:
         get_out() = other.get_out();
     }
 
-    item_shared_data<Rank, OutType> get_out() { return {out_, item_}; }
+    item_shared_data<Rank, OutType> get_out() { return {out_, item_, group_}; }
 
     cl::sycl::item<Rank> get_item() const { return item_; }
 
+    const work_group<Rank> *get_group() const { return group_; }
+
 private:
     std::tuple<T, Ts...> in_;
     OutType out_;
     cl::sycl::item<Rank> item_;
+    const work_group<Rank> *group_;
 };
 
 template <typename FirstContext, typename LastContext>
@@ -305,6 +321,30 @@ struct combined_context<item_context<Rank, OutType(T, Ts...)>, item_context<Rank
 template <typename FirstContext, typename LastContext>
 using combined_context_t = typename combined_context<FirstContext, LastContext>::type;
 
+template <typename Context>
+struct first_input;
+
+template <int Rank, typename OutType, typename... InTypes>
+struct first_input<item_context<Rank, OutType(InTypes...)>> : std::tuple_element<0, std::tuple<InTypes..., void>>
+{
+};
+
+template <typename Context>
+using first_input_t = typename first_input<Context>::type;
+
+template <int Rank, typename OutType, typename T, typename... Ts>
+auto get_first_in(item_context<Rank, OutType(T, Ts...)> &ctx)
+{
+    if constexpr (sizeof...(Ts) == 0)
+    {
+        return ctx.get_in();
+    }
+    else
+    {
+        return ctx.template get_in<0>();
+    }
+}
+
 template <typename Signatur>
 struct item_context_from_signature;
 
@@ -347,6 +387,13 @@ struct item_context_from_signature<
 template <typename Signature>
 using item_context_from_signature_t = typename item_context_from_signature<Signature>::type;
 
+// the item passed to the kernels of the user, it converts to a cl::sycl::item for kernels which do not need the group
+template <typename ItemContext>
+group_item<ItemContext::rank> get_group_item(const ItemContext &ctx)
+{
+    return {ctx.get_item(), ctx.get_group()};
+}
+
 } // namespace detail
 
 namespace traits
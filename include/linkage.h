@@ -46,6 +46,27 @@ namespace celerity::algorithm::detail
 #endif
 		}
 
+		template <typename T, typename U>
+		auto link_tiled(T lhs, U rhs)
+		{
+#ifdef CELERITY_STD_DISABLE_FUSION
+			return link(lhs, rhs);
+#else
+			using value_type = typename traits::packaged_task_traits<T>::output_value_type;
+			using tile_type = traits::first_input_tile_t<U>;
+			constexpr auto rank = traits::packaged_task_traits<T>::rank;
+
+			// the producer still computes single elements, the sink receives the whole tile around its item
+			transient_buffer<value_type, rank> out_buf{lhs.get_range()};
+			transient_buffer<tile_type, rank> tile_buf{lhs.get_range()};
+
+			auto t_left = lhs.complete(begin(out_buf), end(out_buf));
+			auto t_right = rhs.complete(begin(tile_buf), end(tile_buf));
+
+			return sequence(t_left, t_right);
+#endif
+		}
+
 		template <typename T, require<!traits::is_internally_linked_v<T>> = yes>
 		auto link_internally(T t_joint)
 		{
@@ -98,10 +119,14 @@ namespace celerity::algorithm::detail
 			auto l = link_internally(lhs);
 			auto r = link_internally(rhs);
 
-			if constexpr (is_transiently_linkable_source_v<decltype(l)> && has_transiently_linkable_first_input_v<decltype(r)>)
+			if constexpr (are_transiently_linkable_v<decltype(l), decltype(r)>)
 			{
 				return link_transiently(l, r);
 			}
+			else if constexpr (are_tile_linkable_v<decltype(l), decltype(r)>)
+			{
+				return link_tiled(l, r);
+			}
 			else if constexpr (is_linkable_source_v<decltype(l)> && is_linkable_sink_v<decltype(r)>)
 			{
 				return link(l, r);
@@ -236,6 +261,12 @@ namespace celerity::algorithm::detail
 		return append(remove_last_element(seq), get_first_element(terminate(get_last_element(seq))));
 	}
 
+	template <typename T, require<traits::is_sequence_v<T>, !traits::is_partially_packaged_task_v<traits::last_element_t<T>>> = yes>
+	auto terminate(T seq)
+	{
+		return seq;
+	}
+
 } // namespace celerity::algorithm::detail
 
 #endif // LINKAGE_H
\ No newline at end of file
@@ -1,9 +1,13 @@
 #ifndef LINKAGE_TRAITS_H
 #define LINKAGE_TRAITS_H
 
+#include "accessor_traits.h"
+#include "accessor_type.h"
 #include "computation_type_traits.h"
 #include "packaged_task_traits.h"
 #include "t_joint.h"
+#include "transient_traits.h"
+#include "tile.h"
 
 namespace celerity::algorithm::traits
 {
@@ -37,6 +41,45 @@ template <typename T>
 inline constexpr bool has_transiently_linkable_second_input_v =
     is_linkable_sink_v<T>&& computation_type_of_v<T, detail::computation_type::zip>&& second_input_access_type_v<T> == detail::access_type::one_to_one;
 
+template <typename T, typename U>
+inline constexpr bool are_transiently_linkable_v =
+    is_transiently_linkable_source_v<T>&& has_transiently_linkable_first_input_v<U>;
+
+// tile of the chunk through which the kernel of a sink reads its first input
+template <typename T>
+struct first_input_tile
+{
+    using kernel_type = kernel_functor_t<T>;
+    using chunk_type = std::decay_t<arg_type_t<kernel_type, get_accessor_type<kernel_type, 0>() == detail::access_type::item ? 1 : 0>>;
+
+    using type = tile_type_t<chunk_type>;
+};
+
+template <typename T>
+using first_input_tile_t = typename first_input_tile<T>::type;
+
+// with overlapped tiling, sinks reading chunks of their first input are linked transiently as well
+// and recompute their producer for every element of the chunk instead of reading an intermediate buffer
+template <typename T, typename U>
+constexpr bool are_tile_linkable()
+{
+#ifdef CELERITY_STD_ENABLE_OVERLAPPED_TILING
+    if constexpr (is_transiently_linkable_source_v<T> && is_linkable_sink_v<U> && access_type_v<U> == detail::access_type::chunk)
+    {
+        // statically typed chunks can only read from a buffer
+        return is_type_erased_view_v<typename first_input_tile<U>::chunk_type>
+               && std::is_same_v<typename first_input_tile_t<U>::value_type, typename packaged_task_traits<T>::output_value_type>;
+    }
+    else
+#endif
+    {
+        return false;
+    }
+}
+
+template <typename T, typename U>
+inline constexpr bool are_tile_linkable_v = are_tile_linkable<T, U>();
+
 template <typename T>
 constexpr inline bool first_input_stage_completed_v =
     is_packaged_task_v<
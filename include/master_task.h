@@ -4,6 +4,7 @@
 #include "policy.h"
 #include "kernel_traits.h"
 #include "task.h"
+#include "buffer_range.h"
 
 namespace celerity::algorithm
 {
@@ -18,8 +19,20 @@ auto master_task(const F &f)
     return task<non_blocking_master_execution_policy>(f);
 }
 
+template <typename T, int Rank>
+auto as_buffer_range(buffer<T, Rank> buf)
+{
+    return buffer_range{begin(buf), end(buf)};
+}
+
+template <typename T, int Rank>
+auto as_buffer_range(buffer_range<T, Rank> range)
+{
+    return range;
+}
+
 template <typename F, int... Ranks, typename... Ts, size_t... Is>
-auto master_task(const F &f, std::tuple<buffer<Ts, Ranks>...> buffers, std::index_sequence<Is...>)
+auto master_task_impl(const F &f, std::tuple<buffer_range<Ts, Ranks>...> ranges, std::index_sequence<Is...>)
 {
     using namespace traits;
     using namespace cl::sycl::access;
@@ -28,15 +41,35 @@ auto master_task(const F &f, std::tuple<buffer<Ts, Ranks>...> buffers, std::inde
 
     static_assert(((traits::is_all_v<traits::arg_type_t<F, Is>>)&&...), "only all<> accessors supported");
 
-    return master_task([=](auto &cgh) {
+    return [=](celerity::handler &cgh) {
         const auto accessors = std::make_tuple(
             get_access<policy_type, mode::read, accessor_type_t<F, Is, Ts>>(cgh,
-                                                                            begin(std::get<Is>(buffers)), end(std::get<Is>(buffers)))...);
+                                                                            begin(std::get<Is>(ranges)), end(std::get<Is>(ranges)))...);
 
         return [=]() {
             f((std::get<Is>(accessors)[cl::sycl::detail::make_item<Ranks>({}, {})])...);
         };
-    });
+    };
+}
+
+// submits the master task f with any master policy, with master_async(q) the returned std::future<void> becomes ready once f has run,
+// f is invoked once, so master_parallel(q) submits like master(q), which lets pipelines keep a single policy
+template <typename ExecutionPolicy, typename F>
+auto submit_master_task(ExecutionPolicy p, const F &f)
+{
+    using policy_type = traits::strip_queue_t<std::decay_t<ExecutionPolicy>>;
+
+    static_assert(!traits::policy_traits<policy_type>::is_distributed, "master policies only");
+    static_assert(algorithm::traits::is_master_task_v<F>, "not a master task");
+
+    if constexpr (traits::returns_future_v<ExecutionPolicy>)
+    {
+        return submit_with_future(p.q, f);
+    }
+    else
+    {
+        return std::invoke(task<policy_type>(f), p.q);
+    }
 }
 
 } // namespace detail
@@ -44,19 +77,21 @@ auto master_task(const F &f, std::tuple<buffer<Ts, Ranks>...> buffers, std::inde
 template <typename ExecutionPolicy, typename F>
 auto master_task(ExecutionPolicy p, const F &f)
 {
-    static_assert(std::is_same_v<detail::non_blocking_master_execution_policy, std::decay_t<ExecutionPolicy>>, "non-blocking master only");
-    return std::invoke(detail::master_task(f), p.q);
+    return detail::submit_master_task(p, f);
 }
 
-template <typename ExecutionPolicy, typename F, int... Ranks, typename... Ts>
-auto master_task(ExecutionPolicy p, std::tuple<buffer<Ts, Ranks>...> buffers, const F &f)
+// only the selected part of a buffer range is transferred to the master, e.g.
+// master_task(master(q), subrange_of(grid, skip<2>({row, 0}), take<2>({1, n})), [](all<float, 2> r) { ... })
+template <typename ExecutionPolicy, typename F, typename... Ts>
+auto master_task(ExecutionPolicy p, std::tuple<Ts...> buffers, const F &f)
 {
-    constexpr auto buffer_count = std::tuple_size_v<std::tuple<buffer<Ts, Ranks>...>>;
+    constexpr auto buffer_count = sizeof...(Ts);
 
     static_assert(buffer_count == traits::arity_v<F>, "kernel needs to take the same number of arguments as there are buffers");
 
-    return std::invoke(detail::master_task(f, buffers, std::make_index_sequence<buffer_count>{}),
-                       p.q);
+    const auto ranges = std::apply([](auto... b) { return std::make_tuple(detail::as_buffer_range(b)...); }, buffers);
+
+    return detail::submit_master_task(p, detail::master_task_impl(f, ranges, std::make_index_sequence<buffer_count>{}));
 }
 
 template <typename ExecutionPolicy, typename F, int Rank, typename T>
@@ -65,8 +100,15 @@ auto master_task(ExecutionPolicy p, buffer<T, Rank> buf, const F &f)
     return master_task(p, std::make_tuple(buf), f);
 }
 
-template <int... Ranks, typename... Ts>
-auto pack(buffer<Ts, Ranks>... buffers)
+template <typename ExecutionPolicy, typename F, int Rank, typename T>
+auto master_task(ExecutionPolicy p, detail::buffer_range<T, Rank> range, const F &f)
+{
+    return master_task(p, std::make_tuple(range), f);
+}
+
+template <typename... Ts,
+          require<((traits::is_celerity_buffer_v<Ts> || traits::is_buffer_range_v<Ts>)&&...)> = yes>
+auto pack(Ts... buffers)
 {
     return std::tuple{buffers...};
 }
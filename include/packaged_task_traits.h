@@ -61,6 +61,16 @@ constexpr detail::access_type get_second_input_access_type()
 template <typename T>
 constexpr inline auto second_input_access_type_v = get_second_input_access_type<T>();
 
+// the user provided kernel functor of a task which still requires its input
+template <typename T>
+struct kernel_functor
+{
+	using type = void;
+};
+
+template <typename T>
+using kernel_functor_t = typename kernel_functor<T>::type;
+
 template <typename T>
 struct partially_packaged_task_traits : packaged_task_traits<T>
 {
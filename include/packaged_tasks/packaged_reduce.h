@@ -0,0 +1,135 @@
+#ifndef PACKAGED_REDUCE_H
+#define PACKAGED_REDUCE_H
+
+#include "../iterator.h"
+#include "../celerity_helper.h"
+#include "../accessor_type.h"
+#include "../computation_type.h"
+#include "../packaged_task_traits.h"
+#include "../partially_packaged_task.h"
+
+namespace celerity::algorithm
+{
+
+namespace detail
+{
+
+template <int Rank, typename Functor, typename Reduction, typename InputIteratorType, typename OutputValueType>
+class packaged_reduce
+{
+public:
+    static_assert(!std::is_void_v<typename std::iterator_traits<InputIteratorType>::value_type>);
+    static_assert(!std::is_void_v<OutputValueType>);
+
+    packaged_reduce(Functor functor, Reduction reduction, InputIteratorType in_beg, InputIteratorType in_end)
+        : functor_(functor), reduction_(reduction), in_beg_(in_beg), in_end_(in_end)
+    {
+        assert(are_equal(in_beg_.get_buffer(), in_end_.get_buffer()));
+    }
+
+    OutputValueType operator()(celerity::distr_queue &queue) const
+    {
+        return std::invoke(reduction_, queue, get_task(), in_beg_, in_end_);
+    }
+
+    auto get_task() const { return functor_; }
+    auto get_reduction() const { return reduction_; }
+
+    InputIteratorType get_in_beg() const { return in_beg_; }
+    InputIteratorType get_in_end() const { return in_end_; }
+
+    cl::sycl::range<Rank> get_range() const { return distance(in_beg_, in_end_); }
+
+private:
+    Functor functor_;
+    Reduction reduction_;
+    InputIteratorType in_beg_;
+    InputIteratorType in_end_;
+};
+
+template <typename OutputValueType, typename FunctorType, typename Reduction, template <typename, int> typename InIteratorType, typename InputValueType, int Rank>
+auto package_reduce(FunctorType task, Reduction reduction, InIteratorType<InputValueType, Rank> in_beg, InIteratorType<InputValueType, Rank> in_end)
+{
+    return packaged_reduce<Rank, FunctorType, Reduction, InIteratorType<InputValueType, Rank>, OutputValueType>(task, reduction, in_beg, in_end);
+}
+
+template <typename Functor, typename Reduction, typename OutputValueType>
+class partially_packaged_reduce
+{
+public:
+    partially_packaged_reduce(Functor f, Reduction reduction)
+        : f_(f), reduction_(reduction) {}
+
+    template <typename Iterator>
+    auto complete(Iterator beg, Iterator end) const
+    {
+        const auto t = std::invoke(f_, beg, end);
+        return package_reduce<OutputValueType>(t, reduction_, beg, end);
+    }
+
+private:
+    Functor f_;
+    Reduction reduction_;
+};
+
+template <typename OutputValueType, typename FunctorType, typename Reduction>
+auto package_reduce(FunctorType functor, Reduction reduction)
+{
+    return partially_packaged_reduce<FunctorType, Reduction, OutputValueType>(functor, reduction);
+}
+
+} // namespace detail
+
+namespace traits
+{
+
+template <int Rank, typename Functor, typename Reduction, typename InputIteratorType, typename OutputValueType>
+struct is_packaged_task<detail::packaged_reduce<Rank, Functor, Reduction, InputIteratorType, OutputValueType>>
+    : std::true_type
+{
+};
+
+template <typename Functor, typename Reduction, typename OutputValueType>
+struct is_partially_packaged_task<detail::partially_packaged_reduce<Functor, Reduction, OutputValueType>>
+    : std::true_type
+{
+};
+
+template <int Rank, typename Functor, typename Reduction, typename InputIteratorType, typename OutputValueType>
+struct packaged_task_traits<detail::packaged_reduce<Rank, Functor, Reduction, InputIteratorType, OutputValueType>>
+{
+    static constexpr auto rank = Rank;
+    static constexpr auto computation_type = detail::computation_type::reduce;
+    static constexpr auto access_type = detail::access_type::one_to_one;
+
+    using input_iterator_type = InputIteratorType;
+    using input_value_type = typename std::iterator_traits<InputIteratorType>::value_type;
+    using output_value_type = OutputValueType;
+    using output_iterator_type = void;
+};
+
+template <typename Functor, typename Reduction, typename OutputValueType>
+struct packaged_task_traits<detail::partially_packaged_reduce<Functor, Reduction, OutputValueType>>
+{
+    static constexpr auto rank = -1;
+    static constexpr auto computation_type = detail::computation_type::reduce;
+    static constexpr auto access_type = detail::access_type::one_to_one;
+
+    using input_iterator_type = void;
+    using input_value_type = void;
+    using output_value_type = OutputValueType;
+    using output_iterator_type = void;
+};
+
+template <typename Functor, typename Reduction, typename OutputValueType>
+struct partially_packaged_task_traits<detail::partially_packaged_reduce<Functor, Reduction, OutputValueType>>
+    : packaged_task_traits<detail::partially_packaged_reduce<Functor, Reduction, OutputValueType>>
+{
+    static constexpr auto requirement = detail::stage_requirement::input;
+};
+
+} // namespace traits
+
+} // namespace celerity::algorithm
+
+#endif // PACKAGED_REDUCE_H
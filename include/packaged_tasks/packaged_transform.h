@@ -188,6 +188,12 @@ namespace celerity::algorithm
             static constexpr auto requirement = detail::stage_requirement::input;
         };
 
+        template <detail::access_type InputAccessType, typename Functor, typename KernelFunctor>
+        struct kernel_functor<detail::partially_packaged_transform_0<InputAccessType, Functor, KernelFunctor>>
+        {
+            using type = KernelFunctor;
+        };
+
     } // namespace traits
 
 } // namespace celerity::algorithm
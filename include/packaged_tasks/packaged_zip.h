@@ -442,6 +442,17 @@ struct partially_packaged_task_traits<detail::partially_packaged_zip_1<FunctorTy
     static constexpr auto requirement = detail::stage_requirement::input;
 };
 
+template <typename FunctorType,
+          typename KernelType,
+          typename SecondInputIteratorType,
+          int Rank,
+          detail::access_type FirstInputAccessType,
+          detail::access_type SecondInputAccessType>
+struct kernel_functor<detail::partially_packaged_zip_1<FunctorType, KernelType, SecondInputIteratorType, Rank, FirstInputAccessType, SecondInputAccessType>>
+{
+    using type = KernelType;
+};
+
 template <typename FunctorType,
           typename KernelType,
           detail::access_type FirstInputAccessType,
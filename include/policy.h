@@ -4,6 +4,9 @@
 #include "celerity_helper.h"
 #include "policy_traits.h"
 
+#include <type_traits>
+#include <utility>
+
 namespace celerity::algorithm
 {
 
@@ -14,18 +17,48 @@ struct distributed_execution_policy
 {
 };
 
-template <typename KernelName>
+// LocalExtents is the size of the work groups the task is launched in, one extent per dimension,
+// without extents the runtime chooses how to group the work items
+template <typename KernelName, size_t... LocalExtents>
 struct named_distributed_execution_policy : distributed_execution_policy
 {
 };
 
-template <typename KernelName>
-struct named_distributed_execution_and_queue_policy : named_distributed_execution_policy<KernelName>
+template <typename KernelName, size_t... LocalExtents>
+struct named_distributed_execution_and_queue_policy : named_distributed_execution_policy<KernelName, LocalExtents...>
 {
 	explicit named_distributed_execution_and_queue_policy(distr_queue &queue) : q(queue) {}
 	::celerity::distr_queue q;
 };
 
+// every work item processes Factor contiguous elements along the last dimension by running the scalar kernel for each of them,
+// this coarsens the launch but does not vectorize it: accessors of buffers only yield single elements
+// and do not expose where an element lies in the allocation backing the buffer on a node
+template <typename KernelName, size_t Factor>
+struct named_distributed_coarsened_policy : distributed_execution_policy
+{
+	static_assert(Factor > 0, "every work item must process at least one element");
+};
+
+template <typename KernelName, size_t Factor>
+struct named_distributed_coarsened_and_queue_policy : named_distributed_coarsened_policy<KernelName, Factor>
+{
+	explicit named_distributed_coarsened_and_queue_policy(distr_queue &queue) : q(queue) {}
+	::celerity::distr_queue q;
+};
+
+// the task runs on the host of every node over the chunk of that node,
+// its accessors are mapped like the accessors of a kernel
+struct distributed_host_execution_policy : distributed_execution_policy
+{
+};
+
+struct distributed_host_execution_and_queue_policy : distributed_host_execution_policy
+{
+	explicit distributed_host_execution_and_queue_policy(distr_queue &queue) : q(queue) {}
+	::celerity::distr_queue q;
+};
+
 struct non_blocking_master_execution_policy
 {
 	::celerity::distr_queue q;
@@ -36,36 +69,95 @@ struct blocking_master_execution_policy
 	::celerity::distr_queue q;
 };
 
+// submits like the non-blocking master policy, the algorithms return a std::future
+// which becomes ready once the result is available
+struct async_master_execution_policy
+{
+	::celerity::distr_queue q;
+};
+
+// the items of the task are processed by all host threads of the master node,
+// so the functor is invoked concurrently
+template <bool Blocking>
+struct parallel_master_execution_policy
+{
+	::celerity::distr_queue q;
+};
+
 } // namespace detail
 
-template <typename KernelName>
-auto distr(::celerity::distr_queue q) { return detail::named_distributed_execution_and_queue_policy<KernelName>{q}; }
+template <typename KernelName, size_t... LocalExtents>
+auto distr(::celerity::distr_queue q) { return detail::named_distributed_execution_and_queue_policy<KernelName, LocalExtents...>{q}; }
 
 template <typename KernelName>
 auto distr() { return detail::named_distributed_execution_policy<KernelName>{}; }
 
+template <typename KernelName, size_t Factor>
+auto distr_coarse(::celerity::distr_queue q) { return detail::named_distributed_coarsened_and_queue_policy<KernelName, Factor>{q}; }
+
+inline auto distr_host(::celerity::distr_queue q) { return detail::distributed_host_execution_and_queue_policy{q}; }
+
 inline auto master(celerity::distr_queue q) { return detail::non_blocking_master_execution_policy{q}; }
 inline auto master_blocking(celerity::distr_queue q) { return detail::blocking_master_execution_policy{q}; }
+inline auto master_async(celerity::distr_queue q) { return detail::async_master_execution_policy{q}; }
+inline auto master_parallel(celerity::distr_queue q) { return detail::parallel_master_execution_policy<false>{q}; }
+inline auto master_parallel_blocking(celerity::distr_queue q) { return detail::parallel_master_execution_policy<true>{q}; }
 
 namespace traits
 {
 
-template <typename KernelName>
-struct decay_policy<detail::named_distributed_execution_policy<KernelName>>
+template <typename KernelName, size_t... LocalExtents>
+struct decay_policy<detail::named_distributed_execution_policy<KernelName, LocalExtents...>>
 {
 	using type = detail::distributed_execution_policy;
 };
 
-template <typename KernelName>
-struct decay_policy<detail::named_distributed_execution_and_queue_policy<KernelName>>
+template <typename KernelName, size_t... LocalExtents>
+struct decay_policy<detail::named_distributed_execution_and_queue_policy<KernelName, LocalExtents...>>
 {
-	using type = detail::named_distributed_execution_policy<KernelName>;
+	using type = detail::named_distributed_execution_policy<KernelName, LocalExtents...>;
 };
 
-template <typename KernelName>
-struct strip_queue<detail::named_distributed_execution_and_queue_policy<KernelName>>
+template <typename KernelName, size_t... LocalExtents>
+struct strip_queue<detail::named_distributed_execution_and_queue_policy<KernelName, LocalExtents...>>
+{
+	using type = traits::decay_policy_t<detail::named_distributed_execution_and_queue_policy<KernelName, LocalExtents...>>;
+};
+
+template <typename KernelName, size_t Factor>
+struct decay_policy<detail::named_distributed_coarsened_policy<KernelName, Factor>>
+{
+	using type = detail::distributed_execution_policy;
+};
+
+template <typename KernelName, size_t Factor>
+struct decay_policy<detail::named_distributed_coarsened_and_queue_policy<KernelName, Factor>>
+{
+	using type = detail::named_distributed_coarsened_policy<KernelName, Factor>;
+};
+
+template <typename KernelName, size_t Factor>
+struct strip_queue<detail::named_distributed_coarsened_and_queue_policy<KernelName, Factor>>
+{
+	using type = traits::decay_policy_t<detail::named_distributed_coarsened_and_queue_policy<KernelName, Factor>>;
+};
+
+template <>
+struct decay_policy<detail::distributed_host_execution_policy>
 {
-	using type = traits::decay_policy_t<detail::named_distributed_execution_and_queue_policy<KernelName>>;
+	using type = detail::distributed_execution_policy;
+};
+
+template <>
+struct decay_policy<detail::distributed_host_execution_and_queue_policy>
+{
+	using type = detail::distributed_host_execution_policy;
+};
+
+template <>
+struct strip_queue<detail::distributed_host_execution_and_queue_policy>
+{
+	using type = traits::decay_policy_t<detail::distributed_host_execution_and_queue_policy>;
 };
 
 template <>
@@ -82,6 +174,33 @@ struct policy_traits<detail::blocking_master_execution_policy>
 	static constexpr bool is_blocking = true;
 };
 
+template <>
+struct strip_queue<detail::async_master_execution_policy>
+{
+	using type = detail::non_blocking_master_execution_policy;
+};
+
+template <>
+struct policy_traits<detail::async_master_execution_policy>
+{
+	static constexpr bool is_distributed = false;
+	static constexpr bool is_blocking = false;
+};
+
+template <>
+struct policy_traits<detail::distributed_host_execution_policy>
+{
+	static constexpr bool is_distributed = true;
+	static constexpr bool is_blocking = false;
+};
+
+template <bool Blocking>
+struct policy_traits<detail::parallel_master_execution_policy<Blocking>>
+{
+	static constexpr bool is_distributed = false;
+	static constexpr bool is_blocking = Blocking;
+};
+
 template <>
 struct policy_traits<detail::distributed_execution_policy>
 {
@@ -89,13 +208,164 @@ struct policy_traits<detail::distributed_execution_policy>
 	static constexpr bool is_blocking = false;
 };
 
-template <typename KernelName>
-struct policy_traits<detail::named_distributed_execution_policy<KernelName>>
+template <typename KernelName, size_t... LocalExtents>
+struct policy_traits<detail::named_distributed_execution_policy<KernelName, LocalExtents...>>
+{
+	static constexpr bool is_distributed = true;
+	using kernel_name = KernelName;
+};
+
+template <typename KernelName, size_t Factor>
+struct policy_traits<detail::named_distributed_coarsened_policy<KernelName, Factor>>
 {
 	static constexpr bool is_distributed = true;
 	using kernel_name = KernelName;
 };
 
+// number of contiguous elements every work item of a task processes
+template <typename Policy>
+struct coarsening_factor : std::integral_constant<size_t, 1>
+{
+};
+
+template <typename KernelName, size_t Factor>
+struct coarsening_factor<detail::named_distributed_coarsened_policy<KernelName, Factor>> : std::integral_constant<size_t, Factor>
+{
+};
+
+template <typename Policy>
+inline constexpr size_t coarsening_factor_v = coarsening_factor<Policy>::value;
+
+// algorithms invoked with the policy return a std::future instead of blocking or returning nothing
+template <typename Policy>
+struct returns_future : std::is_same<Policy, detail::async_master_execution_policy>
+{
+};
+
+template <typename Policy>
+inline constexpr bool returns_future_v = returns_future<std::decay_t<Policy>>::value;
+
+// target of the range mapped accessors of distributed tasks
+template <typename Policy>
+struct distributed_accessor_target : std::integral_constant<cl::sycl::access::target, cl::sycl::access::target::global_buffer>
+{
+};
+
+template <>
+struct distributed_accessor_target<detail::distributed_host_execution_policy>
+	: std::integral_constant<cl::sycl::access::target, cl::sycl::access::target::host_buffer>
+{
+};
+
+template <typename Policy>
+inline constexpr auto distributed_accessor_target_v = distributed_accessor_target<Policy>::value;
+
+// master tasks whose items are processed by all host threads
+template <typename Policy>
+struct runs_on_host_threads : std::bool_constant<false>
+{
+};
+
+template <bool Blocking>
+struct runs_on_host_threads<detail::parallel_master_execution_policy<Blocking>> : std::bool_constant<true>
+{
+};
+
+template <typename Policy>
+inline constexpr bool runs_on_host_threads_v = runs_on_host_threads<Policy>::value;
+
+// tasks launched in work groups stage the input of statically typed views through local memory,
+// only policies requesting a work group size opt into it
+template <typename Policy>
+struct launches_work_groups : std::bool_constant<false>
+{
+};
+
+template <typename KernelName, size_t... LocalExtents>
+struct launches_work_groups<detail::named_distributed_execution_policy<KernelName, LocalExtents...>>
+	: std::bool_constant<(sizeof...(LocalExtents) > 0)>
+{
+};
+
+template <typename Policy>
+inline constexpr bool launches_work_groups_v = launches_work_groups<Policy>::value;
+
+// the same policy launching one work item per element without a fixed work group size,
+// for tasks whose range is unrelated to the range of the user's kernel
+template <typename Policy>
+struct default_launch
+{
+	using type = Policy;
+};
+
+template <typename KernelName, size_t... LocalExtents>
+struct default_launch<detail::named_distributed_execution_policy<KernelName, LocalExtents...>>
+{
+	using type = detail::named_distributed_execution_policy<KernelName>;
+};
+
+template <typename KernelName, size_t Factor>
+struct default_launch<detail::named_distributed_coarsened_policy<KernelName, Factor>>
+{
+	using type = detail::named_distributed_execution_policy<KernelName>;
+};
+
+template <typename Policy>
+using default_launch_t = typename default_launch<Policy>::type;
+
+// the policy of the tasks an algorithm lays out itself, like the work groups of a reduction or the blocks of a sort:
+// they are not launched over the input, so a launch configured for the input does not apply to them
+template <typename ExecutionPolicy>
+using internal_launch_t = default_launch_t<strip_queue_t<ExecutionPolicy>>;
+
+// the work group size a policy requests, empty if it leaves the grouping to the runtime
+template <typename Policy>
+struct local_extents
+{
+	using type = std::index_sequence<>;
+};
+
+template <typename KernelName, size_t... LocalExtents>
+struct local_extents<detail::named_distributed_execution_policy<KernelName, LocalExtents...>>
+{
+	using type = std::index_sequence<LocalExtents...>;
+};
+
+template <typename Policy>
+using local_extents_t = typename local_extents<Policy>::type;
+
+// fused tasks are launched in the work groups any of their parts requests, parts requesting different sizes cannot be fused
+template <typename... LocalExtents>
+struct merged_local_extents;
+
+template <typename LocalExtents>
+struct merged_local_extents<LocalExtents>
+{
+	using type = LocalExtents;
+};
+
+template <size_t... As, size_t... Bs, typename... Rest>
+struct merged_local_extents<std::index_sequence<As...>, std::index_sequence<Bs...>, Rest...>
+{
+	static_assert(sizeof...(As) == 0 || sizeof...(Bs) == 0 || std::is_same_v<std::index_sequence<As...>, std::index_sequence<Bs...>>,
+				  "fused tasks must request the same work group size");
+
+	using type = typename merged_local_extents<std::conditional_t<(sizeof...(As) > 0), std::index_sequence<As...>, std::index_sequence<Bs...>>, Rest...>::type;
+};
+
+template <typename KernelName, typename LocalExtents>
+struct named_policy;
+
+template <typename KernelName, size_t... LocalExtents>
+struct named_policy<KernelName, std::index_sequence<LocalExtents...>>
+{
+	using type = detail::named_distributed_execution_policy<KernelName, LocalExtents...>;
+};
+
+// the policy of a task fusing the tasks of Policies
+template <typename KernelName, typename... Policies>
+using fused_policy_t = typename named_policy<KernelName, typename merged_local_extents<local_extents_t<Policies>...>::type>::type;
+
 } // namespace traits
 
 } // namespace celerity::algorithm
@@ -137,6 +407,12 @@ struct fused
 {
 };
 
+// kernel name of a later pass of an algorithm whose passes run kernels of the same stage, the first pass is named KernelName
+template <typename KernelName, size_t Pass>
+struct nth_pass
+{
+};
+
 namespace celerity::algorithm::traits
 {
 template <typename FirstKernel, typename SecondKernel>
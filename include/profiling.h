@@ -0,0 +1,309 @@
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include "policy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace celerity::algorithm
+{
+
+// what the kernels of one stage cost on this node, stages of fused kernels share the cost of the fused kernel evenly,
+// recording a task submits an extra host task after it and transfers one element of every chunk it writes to the host
+struct stage_profile
+{
+	size_t submissions = 0;
+	// submissions in which the stage was fused with other stages
+	size_t fused_submissions = 0;
+	double submission_seconds = 0;
+	// host wall time from the submission, or the completion of the previously recorded task if later, until the host task
+	// recording the chunk of this node ran, which includes the transfer of the recorded elements and is not the time of the kernel
+	double completion_seconds = 0;
+	// bytes of global buffers the range mappers of the stage map the chunk of this node to, transient buffers of fused kernels are not counted
+	size_t accessed_bytes = 0;
+};
+
+// collects the stage profiles of all tasks submitted with CELERITY_STD_ENABLE_PROFILING defined,
+// the execution of a task is recorded asynchronously, so the queue has to be synchronized before reading the profiles
+class profiler
+{
+public:
+	static profiler &instance()
+	{
+		static profiler p;
+		return p;
+	}
+
+	using clock = std::chrono::steady_clock;
+
+	void record_submission(const std::vector<std::string> &stages, double submission_seconds)
+	{
+		const std::lock_guard lock{mutex_};
+		const auto share = static_cast<double>(stages.size());
+
+		for (const auto &name : stages)
+		{
+			auto &profile = profiles_[name];
+
+			profile.submissions++;
+			profile.fused_submissions += stages.size() > 1 ? 1 : 0;
+			profile.submission_seconds += submission_seconds / share;
+		}
+	}
+
+	// tasks are recorded in the order their chunks complete, a task is only charged for the time after the previous one completed
+	void record_execution(const std::vector<std::string> &stages, clock::time_point submitted, clock::time_point finished, size_t accessed_bytes)
+	{
+		const std::lock_guard lock{mutex_};
+		const auto share = static_cast<double>(stages.size());
+		const auto completion_seconds = std::chrono::duration<double>(finished - std::max(submitted, std::min(last_finished_, finished))).count();
+
+		last_finished_ = std::max(last_finished_, finished);
+
+		// the last stage receives the bytes left over by the even split, so no byte is lost
+		const auto bytes_per_stage = accessed_bytes / stages.size();
+
+		for (size_t i = 0; i < stages.size(); ++i)
+		{
+			auto &profile = profiles_[stages[i]];
+
+			profile.completion_seconds += completion_seconds / share;
+			profile.accessed_bytes += i + 1 < stages.size() ? bytes_per_stage : accessed_bytes - bytes_per_stage * i;
+		}
+	}
+
+	std::map<std::string, stage_profile> get_profiles() const
+	{
+		const std::lock_guard lock{mutex_};
+		return profiles_;
+	}
+
+	void reset()
+	{
+		const std::lock_guard lock{mutex_};
+		profiles_.clear();
+	}
+
+	void report(std::ostream &os) const
+	{
+		char line[256];
+
+		for (const auto &[name, profile] : get_profiles())
+		{
+			std::snprintf(line, sizeof(line), "%8zu %8zu %12.3f %12.3f %12.3f  ", profile.submissions, profile.fused_submissions,
+						  profile.submission_seconds * 1e3, profile.completion_seconds * 1e3, static_cast<double>(profile.accessed_bytes) / (1 << 20));
+			os << line << name << '\n';
+		}
+	}
+
+private:
+	profiler() = default;
+
+	mutable std::mutex mutex_;
+	std::map<std::string, stage_profile> profiles_;
+	clock::time_point last_finished_{};
+};
+
+namespace detail
+{
+
+// kernel names are usually incomplete types, so the name is taken from a pointer to T
+template <typename T>
+std::string type_name()
+{
+	std::string name = typeid(T *).name();
+
+#if defined(__GNUG__)
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+
+	if (status == 0)
+	{
+		name = demangled;
+		std::free(demangled);
+
+		if (!name.empty() && name.back() == '*')
+		{
+			name.pop_back();
+		}
+	}
+#endif
+
+	return name;
+}
+
+// the names of the stages a kernel was built from, the kernel of a fused task is named fused<PolicyA, PolicyB>
+template <typename KernelName>
+struct stage_names
+{
+	static void append(std::vector<std::string> &names) { names.push_back(type_name<KernelName>()); }
+};
+
+template <typename KernelName, size_t... LocalExtents>
+struct stage_names<named_distributed_execution_policy<KernelName, LocalExtents...>> : stage_names<KernelName>
+{
+};
+
+template <typename KernelName, size_t Factor>
+struct stage_names<named_distributed_coarsened_policy<KernelName, Factor>> : stage_names<KernelName>
+{
+};
+
+template <typename KernelName, size_t Pass>
+struct stage_names<nth_pass<KernelName, Pass>> : stage_names<KernelName>
+{
+};
+
+template <typename FirstKernel, typename SecondKernel>
+struct stage_names<fused<FirstKernel, SecondKernel>>
+{
+	static void append(std::vector<std::string> &names)
+	{
+		stage_names<FirstKernel>::append(names);
+		stage_names<SecondKernel>::append(names);
+	}
+};
+
+template <typename KernelName>
+std::vector<std::string> get_stage_names()
+{
+	std::vector<std::string> names;
+	stage_names<KernelName>::append(names);
+	return names;
+}
+
+// the accessors of the task whose command group is currently built, it is only set while a task is recorded
+template <int Rank>
+struct recorded_launch
+{
+	// the bytes every accessor maps a chunk of elements to
+	std::vector<std::function<size_t(celerity::chunk<Rank>)>> accessed_bytes;
+	// request one element of every chunk of a buffer the task writes, so a host task requesting them runs once the chunk is written
+	std::vector<std::function<void(celerity::handler &)>> written;
+};
+
+template <int Rank>
+inline thread_local recorded_launch<Rank> *current_launch = nullptr;
+
+// records an accessor of the current task, mapper maps chunks of the elements the task is launched for,
+// accessors of buffers whose rank differs from the launch are not recorded
+template <cl::sycl::access::mode Mode, typename T, int Rank, typename RangeMapper>
+void record_access(celerity::buffer<T, Rank> buffer, RangeMapper mapper)
+{
+	using namespace cl::sycl::access;
+
+	auto *launch = current_launch<Rank>;
+
+	if (launch == nullptr)
+	{
+		return;
+	}
+
+	launch->accessed_bytes.push_back([mapper](celerity::chunk<Rank> chnk) { return mapper(chnk).range.size() * sizeof(T); });
+
+	if constexpr (Mode != mode::read)
+	{
+		launch->written.push_back([buffer, mapper](celerity::handler &cgh) {
+			buffer.template get_access<mode::read, target::host_buffer>(cgh, [mapper](celerity::chunk<Rank> chnk) {
+				auto sr = mapper(chnk);
+
+				for (auto i = 0; i < Rank; ++i)
+				{
+					sr.range[i] = std::min<size_t>(sr.range[i], 1);
+				}
+
+				return sr;
+			});
+		});
+	}
+}
+
+// measures the submission and execution of one task without synchronizing the queue, after the task a host task over
+// the same range requests one element of every chunk the task writes and takes the timestamp on every node once the
+// chunk of the node is written, tasks which write no global buffer only record their submission
+template <typename KernelName, int Rank>
+class stage_recorder
+{
+public:
+	using clock = profiler::clock;
+
+	stage_recorder(distr_queue &q, cl::sycl::id<Rank> offset, cl::sycl::range<Rank> range)
+		: q_(q), offset_(offset), range_(range)
+	{
+		current_launch<Rank> = &launch_;
+		start_ = clock::now();
+	}
+
+	~stage_recorder()
+	{
+		current_launch<Rank> = nullptr;
+	}
+
+	stage_recorder(const stage_recorder &) = delete;
+	stage_recorder &operator=(const stage_recorder &) = delete;
+
+	// to be called once the task is submitted
+	void record()
+	{
+		current_launch<Rank> = nullptr;
+
+		const auto submitted = clock::now();
+		const auto stages = get_stage_names<KernelName>();
+
+		profiler::instance().record_submission(stages, std::chrono::duration<double>(submitted - start_).count());
+
+		if (launch_.written.empty())
+		{
+			return;
+		}
+
+		q_.submit(celerity::allow_by_ref, [launch = launch_, stages, submitted, offset = offset_, range = range_](celerity::handler &cgh) {
+			for (const auto &request : launch.written)
+			{
+				request(cgh);
+			}
+
+			cgh.host_task(range, offset, [=](celerity::partition<Rank> part) {
+				const auto finished = clock::now();
+				const auto sr = part.get_subrange();
+				const celerity::chunk<Rank> chnk{sr.offset, sr.range, part.get_global_size()};
+
+				size_t accessed_bytes = 0;
+
+				for (const auto &bytes : launch.accessed_bytes)
+				{
+					accessed_bytes += bytes(chnk);
+				}
+
+				profiler::instance().record_execution(stages, submitted, finished, accessed_bytes);
+			});
+		});
+	}
+
+private:
+	distr_queue &q_;
+	cl::sycl::id<Rank> offset_;
+	cl::sycl::range<Rank> range_;
+	recorded_launch<Rank> launch_;
+	clock::time_point start_;
+};
+
+} // namespace detail
+
+} // namespace celerity::algorithm
+
+#endif // PROFILING_H
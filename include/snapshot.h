@@ -0,0 +1,262 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "iterator.h"
+#include "policy.h"
+#include "algorithms/copy.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace celerity::algorithm
+{
+
+enum class snapshot_compression
+{
+    none,
+    // bytes which did not change since the previous frame are stored as runs of their count
+    delta
+};
+
+namespace detail
+{
+
+// equal bytes shorter than this are kept in the literals, a run header would not be smaller
+inline constexpr size_t min_delta_run = 2 * sizeof(uint32_t);
+
+template <typename Integer>
+void append_bytes(std::vector<char> &out, Integer value)
+{
+    const auto pos = out.size();
+    out.resize(pos + sizeof(Integer));
+    std::memcpy(out.data() + pos, &value, sizeof(Integer));
+}
+
+template <typename Integer>
+Integer read_bytes(const char *in)
+{
+    Integer value;
+    std::memcpy(&value, in, sizeof(Integer));
+    return value;
+}
+
+// encodes frame as its size followed by pairs of (unchanged count, literal count, literals) relative to previous,
+// previous is replaced by frame
+inline std::vector<char> encode_delta(const char *frame, size_t size, std::vector<char> &previous)
+{
+    previous.resize(size, 0);
+
+    std::vector<char> out;
+    append_bytes(out, static_cast<uint64_t>(size));
+
+    for (size_t i = 0; i < size;)
+    {
+        const auto unchanged_first = i;
+
+        while (i < size && frame[i] == previous[i])
+        {
+            ++i;
+        }
+
+        const auto literals_first = i;
+        auto literals_last = i;
+
+        for (; i < size && i - literals_last < min_delta_run; ++i)
+        {
+            if (frame[i] != previous[i])
+            {
+                literals_last = i + 1;
+            }
+        }
+
+        i = literals_last;
+
+        append_bytes(out, static_cast<uint32_t>(literals_first - unchanged_first));
+        append_bytes(out, static_cast<uint32_t>(literals_last - literals_first));
+        out.insert(out.end(), frame + literals_first, frame + literals_last);
+    }
+
+    std::memcpy(previous.data(), frame, size);
+
+    return out;
+}
+
+// decodes a frame produced by encode_delta into previous, which holds the frame encoded before
+inline void decode_delta(const char *in, size_t size, std::vector<char> &previous)
+{
+    previous.resize(read_bytes<uint64_t>(in), 0);
+
+    for (size_t pos = sizeof(uint64_t), i = 0; pos < size;)
+    {
+        i += read_bytes<uint32_t>(in + pos);
+        const auto literals = read_bytes<uint32_t>(in + pos + sizeof(uint32_t));
+        pos += 2 * sizeof(uint32_t);
+
+        std::memcpy(previous.data() + i, in + pos, literals);
+        i += literals;
+        pos += literals;
+    }
+}
+
+} // namespace detail
+
+// writes frames on a background thread, write(index, bytes, size) is invoked for every frame in order,
+// pushing a frame only waits if capacity frames are still pending, so a slow writer throttles the capture
+template <typename T>
+class snapshot_writer
+{
+public:
+    using write_type = std::function<void(size_t, const char *, size_t)>;
+
+    static_assert(std::is_trivially_copyable_v<T>, "frames are written as raw bytes");
+
+    explicit snapshot_writer(write_type write, size_t capacity = 2, snapshot_compression compression = snapshot_compression::none)
+        : write_(std::move(write)), capacity_(std::max<size_t>(capacity, 1)), compression_(compression), thread_([this]() { run(); })
+    {
+    }
+
+    // writes the pending frames before returning
+    ~snapshot_writer()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            closed_ = true;
+        }
+
+        pushed_.notify_one();
+        thread_.join();
+    }
+
+    snapshot_writer(const snapshot_writer &) = delete;
+    snapshot_writer &operator=(const snapshot_writer &) = delete;
+
+    void push(std::vector<T> frame)
+    {
+        std::unique_lock lock{mutex_};
+        popped_.wait(lock, [this]() { return frames_.size() < capacity_; });
+
+        frames_.push_back(std::move(frame));
+
+        lock.unlock();
+        pushed_.notify_one();
+    }
+
+    // waits until all pushed frames are written
+    void flush()
+    {
+        std::unique_lock lock{mutex_};
+        popped_.wait(lock, [this]() { return frames_.empty() && !writing_; });
+    }
+
+private:
+    void run()
+    {
+        std::vector<char> previous;
+
+        for (size_t index = 0;; ++index)
+        {
+            std::unique_lock lock{mutex_};
+            pushed_.wait(lock, [this]() { return !frames_.empty() || closed_; });
+
+            if (frames_.empty())
+            {
+                return;
+            }
+
+            auto frame = std::move(frames_.front());
+            frames_.pop_front();
+            writing_ = true;
+
+            lock.unlock();
+            popped_.notify_all();
+
+            const auto *bytes = reinterpret_cast<const char *>(frame.data());
+            const auto size = frame.size() * sizeof(T);
+
+            if (compression_ == snapshot_compression::delta)
+            {
+                const auto encoded = detail::encode_delta(bytes, size, previous);
+                write_(index, encoded.data(), encoded.size());
+            }
+            else
+            {
+                write_(index, bytes, size);
+            }
+
+            lock.lock();
+            writing_ = false;
+
+            lock.unlock();
+            popped_.notify_all();
+        }
+    }
+
+    write_type write_;
+    size_t capacity_;
+    snapshot_compression compression_;
+
+    std::mutex mutex_;
+    std::condition_variable pushed_;
+    std::condition_variable popped_;
+    std::deque<std::vector<T>> frames_;
+    bool writing_ = false;
+    bool closed_ = false;
+
+    std::thread thread_;
+};
+
+// restores the frames written with snapshot_compression::delta, which have to be decoded in order
+template <typename T>
+class snapshot_decoder
+{
+public:
+    std::vector<T> operator()(const char *bytes, size_t size)
+    {
+        detail::decode_delta(bytes, size, previous_);
+
+        std::vector<T> frame(previous_.size() / sizeof(T));
+        std::memcpy(frame.data(), previous_.data(), frame.size() * sizeof(T));
+        return frame;
+    }
+
+private:
+    std::vector<char> previous_;
+};
+
+// captures [beg, end) on the master in blocks of rows_per_block rows and hands the frame to writer,
+// the caller does not wait for the capture and writer has to outlive it
+template <typename ExecutionPolicy, typename T, int Rank>
+void snapshot(ExecutionPolicy p, buffer_iterator<T, Rank> beg, buffer_iterator<T, Rank> end, snapshot_writer<T> &writer, size_t rows_per_block = 64)
+{
+    const auto range = detail::distance(beg, end);
+    const auto last_row = (*beg)[0] + range[0];
+    const auto frame = std::make_shared<std::vector<T>>();
+
+    copy(p, beg, end, [frame, last_row, size = range.size(), w = &writer](celerity::subrange<Rank> block, const host_block<T, Rank> &data) {
+        frame->reserve(size);
+        data.copy_to(std::back_inserter(*frame));
+
+        if (block.offset[0] + block.range[0] == last_row)
+        {
+            w->push(std::move(*frame));
+        }
+    }, rows_per_block);
+}
+
+template <typename ExecutionPolicy, typename T, int Rank>
+void snapshot(ExecutionPolicy p, buffer<T, Rank> in, snapshot_writer<T> &writer, size_t rows_per_block = 64)
+{
+    snapshot(p, begin(in), end(in), writer, rows_per_block);
+}
+
+} // namespace celerity::algorithm
+
+#endif // SNAPSHOT_H
@@ -142,6 +142,19 @@ namespace celerity::algorithm
         }};
   }
 
+  // the part of buf which the subrange specifiers select, e.g. subrange_of(grid, skip<2>({4, 0}), take<2>({2, n}))
+  template <typename T, int Rank, typename... SubrangeSpecifiers,
+            require<(traits::is_iterator_transform_v<SubrangeSpecifiers> && ...)> = yes>
+  auto subrange_of(celerity::buffer<T, Rank> buf, SubrangeSpecifiers... specifiers)
+  {
+    auto first = begin(buf);
+    auto last = end(buf);
+
+    (std::invoke(specifiers, first, last), ...);
+
+    return detail::buffer_range{first, last};
+  }
+
 } // namespace celerity::algorithm
 
 #endif // !SUBRANGE_H
\ No newline at end of file
@@ -139,13 +139,8 @@ struct packaged_task_traits<detail::t_joint<Task, SecondaryInputSequence, Sequen
 
 template <typename Task, typename SecondaryInputSequence, bool SequenceList>
 struct extended_packaged_task_traits<detail::t_joint<Task, SecondaryInputSequence, SequenceList>, detail::computation_type::zip>
+    : extended_packaged_task_traits<Task, detail::computation_type::zip>
 {
-	using traits = extended_packaged_task_traits<Task, detail::computation_type::zip>;
-
-	static constexpr auto second_input_access_type = traits::second_input_access_type;
-
-	using second_input_value_type = typename traits::second_input_value_type;
-	using second_input_iterator_type = typename traits::second_input_iterator_type;
 };
 
 template <typename Task, typename SecondaryInputSequence>
@@ -179,6 +174,11 @@ struct partially_packaged_task_traits<detail::partial_t_joint<Task, SecondaryInp
 {
 };
 
+template <typename Task, typename SecondaryInputSequence>
+struct kernel_functor<detail::partial_t_joint<Task, SecondaryInputSequence>> : kernel_functor<Task>
+{
+};
+
 template <typename T>
 struct is_t_joint : std::bool_constant<false>
 {
@@ -8,8 +8,16 @@
 #include "iterator.h"
 #include "accessor_type.h"
 #include "require.h"
+#include "work_group.h"
+#include "coarsen.h"
+#include "platform.h"
+#include "host_threads.h"
+#include "actions.h"
+#include "profiling.h"
 
 #include <future>
+#include <stdexcept>
+#include <memory>
 
 namespace celerity::algorithm
 {
@@ -20,11 +28,213 @@ namespace celerity::algorithm
 		template <typename ExecutionPolicy, typename... Actions>
 		class task_t;
 
-		template <typename KernelName, typename... Actions>
-		class task_t<named_distributed_execution_policy<KernelName>, Actions...>
+		// the work group size requested by the policy, it must divide the range of the task
+		template <typename KernelName, size_t... LocalExtents, int Rank>
+		cl::sycl::range<Rank> launch_work_group_size(named_distributed_execution_policy<KernelName, LocalExtents...>, cl::sycl::range<Rank> range)
+		{
+			static_assert(sizeof...(LocalExtents) == Rank, "work group size must have one extent per dimension of the task");
+			static_assert(((LocalExtents > 0) && ...), "work groups must not be empty");
+
+			const cl::sycl::range<Rank> local_range{LocalExtents...};
+
+			for (auto i = 0; i < Rank; ++i)
+			{
+				if (range[i] % local_range[i] != 0)
+				{
+					throw std::invalid_argument("work group size does not divide the range of the task");
+				}
+			}
+
+			return local_range;
+		}
+
+		// submits the compute kernels of a task to all nodes, the traits of ExecutionPolicy configure the launch
+		template <typename ExecutionPolicy, typename... Actions>
+		class distributed_task_t
+		{
+		public:
+			using execution_policy_type = ExecutionPolicy;
+			using kernel_name = typename traits::policy_traits<ExecutionPolicy>::kernel_name;
+
+			static_assert(((traits::is_compute_task_v<Actions>)&&...), "task can only contain compute task functors");
+
+			explicit distributed_task_t(sequence<Actions...> &&s)
+				: sequence_(std::move(s)) {}
+
+			explicit distributed_task_t(const sequence<Actions...> &s)
+				: sequence_(s) {}
+
+			distributed_task_t(Actions... f) : sequence_(std::move(f)...) {}
+
+			template <int Rank>
+			void operator()(distr_queue &q, iterator<Rank> beg, iterator<Rank> end) const
+			{
+				using namespace traits;
+				using namespace std;
+
+				const auto d = distance(beg, end);
+
+#ifdef CELERITY_STD_ENABLE_PROFILING
+				stage_recorder<kernel_name, Rank> recorder{q, *beg, d};
+#endif
+
+				// checked before submitting, so a mismatching work group size does not leave a half built command group behind
+				const auto local_range = [&]() {
+					if constexpr (launches_work_groups_v<execution_policy_type>)
+					{
+						return launch_work_group_size(execution_policy_type{}, d);
+					}
+					else
+					{
+						return d;
+					}
+				}();
+
+				q.submit(celerity::allow_by_ref, [seq = sequence_, d, local_range, beg](handler &cgh) {
+					if constexpr (launches_work_groups_v<execution_policy_type>)
+					{
+						const auto r = [&]() {
+							const work_group_scope<Rank> scope{local_range};
+							return invoke(seq, cgh);
+						}();
+
+						using first_kernel_type = first_result_t<decltype(r)>;
+						using item_context_type = decay_t<arg_type_t<first_kernel_type, 0>>;
+
+						static_assert(size_v<decltype(sequence(r))> == 1);
+
+						cgh.template parallel_for<kernel_name>(cl::sycl::nd_range<Rank>{d, local_range, *beg}, [r](cl::sycl::nd_item<Rank> nd_item) {
+							const work_group<Rank> group{nd_item};
+
+							item_context_type ctx{cl::sycl::detail::make_item(nd_item.get_global_id(), nd_item.get_global_range(), nd_item.get_offset()), &group};
+							invoke(sequence(r), ctx);
+						});
+					}
+					else if constexpr (coarsening_factor_v<execution_policy_type> > 1)
+					{
+						constexpr auto factor = coarsening_factor_v<execution_policy_type>;
+
+						const auto r = [&]() {
+							const coarsened_launch_scope<Rank> scope{factor, *beg, d};
+							return invoke(seq, cgh);
+						}();
+
+						using first_kernel_type = first_result_t<decltype(r)>;
+						using item_context_type = decay_t<arg_type_t<first_kernel_type, 0>>;
+
+						static_assert(size_v<decltype(sequence(r))> == 1);
+
+						cgh.template parallel_for<kernel_name>(coarsened_range(d, factor), *beg, [r, d, offset = *beg](cl::sycl::item<Rank> item) {
+							for_each_element<factor>(item, offset, d, [&](cl::sycl::item<Rank> element) {
+								item_context_type ctx{element};
+								invoke(sequence(r), ctx);
+							});
+						});
+					}
+					else
+					{
+						const auto r = invoke(seq, cgh);
+
+						using first_kernel_type = first_result_t<decltype(r)>;
+						using item_context_type = decay_t<arg_type_t<first_kernel_type, 0>>;
+
+						static_assert(size_v<decltype(sequence(r))> == 1);
+
+						cgh.template parallel_for<kernel_name>(d, *beg, [r](cl::sycl::item<Rank> item) {
+							item_context_type ctx{item};
+							invoke(sequence(r), ctx);
+						});
+					}
+				});
+
+#ifdef CELERITY_STD_ENABLE_PROFILING
+				recorder.record();
+#endif
+			}
+
+			// launches work groups of local_range over [beg, end) rounded up to whole groups, the kernels are invoked for the
+			// work items past end as well, they must not evaluate elements there but take part in the barriers of their group
+			template <int Rank>
+			void operator()(distr_queue &q, iterator<Rank> beg, iterator<Rank> end, cl::sycl::range<Rank> local_range) const
+			{
+				using namespace traits;
+				using namespace std;
+
+				const auto d = distance(beg, end);
+				const auto padded = padded_range(d, local_range);
+
+#ifdef CELERITY_STD_ENABLE_PROFILING
+				stage_recorder<kernel_name, Rank> recorder{q, *beg, d};
+#endif
+
+				q.submit(celerity::allow_by_ref, [seq = sequence_, d, padded, local_range, beg](handler &cgh) {
+					// accessors only request the elements of the work items which lie in [beg, end)
+					const auto r = [&]() {
+						const work_group_scope<Rank> groups{local_range};
+						const element_launch_scope<Rank> elements{*beg, d};
+						return invoke(seq, cgh);
+					}();
+
+					using first_kernel_type = first_result_t<decltype(r)>;
+					using item_context_type = decay_t<arg_type_t<first_kernel_type, 0>>;
+
+					static_assert(size_v<decltype(sequence(r))> == 1);
+
+					cgh.template parallel_for<kernel_name>(cl::sycl::nd_range<Rank>{padded, local_range, *beg}, [r](cl::sycl::nd_item<Rank> nd_item) {
+						const work_group<Rank> group{nd_item};
+
+						item_context_type ctx{cl::sycl::detail::make_item(nd_item.get_global_id(), nd_item.get_global_range(), nd_item.get_offset()), &group};
+						invoke(sequence(r), ctx);
+					});
+				});
+
+#ifdef CELERITY_STD_ENABLE_PROFILING
+				recorder.record();
+#endif
+			}
+
+			// launches the kernels for the index space [0, range) of algorithms whose work items correspond to no buffer,
+			// e.g. one work item or work group per block of a buffer
+			template <int Rank>
+			void operator()(distr_queue &q, cl::sycl::range<Rank> range) const
+			{
+				(*this)(q, iterator<Rank>{cl::sycl::id<Rank>{}, range}, iterator<Rank>{cl::sycl::id<Rank>{range}, range});
+			}
+
+			template <int Rank>
+			void operator()(distr_queue &q, cl::sycl::range<Rank> range, cl::sycl::range<Rank> local_range) const
+			{
+				(*this)(q, iterator<Rank>{cl::sycl::id<Rank>{}, range}, iterator<Rank>{cl::sycl::id<Rank>{range}, range}, local_range);
+			}
+
+			auto get_sequence() const { return sequence_; }
+
+		private:
+			sequence<Actions...> sequence_;
+		};
+
+		template <typename KernelName, size_t... LocalExtents, typename... Actions>
+		class task_t<named_distributed_execution_policy<KernelName, LocalExtents...>, Actions...>
+			: public distributed_task_t<named_distributed_execution_policy<KernelName, LocalExtents...>, Actions...>
+		{
+		public:
+			using distributed_task_t<named_distributed_execution_policy<KernelName, LocalExtents...>, Actions...>::distributed_task_t;
+		};
+
+		template <typename KernelName, size_t Factor, typename... Actions>
+		class task_t<named_distributed_coarsened_policy<KernelName, Factor>, Actions...>
+			: public distributed_task_t<named_distributed_coarsened_policy<KernelName, Factor>, Actions...>
+		{
+		public:
+			using distributed_task_t<named_distributed_coarsened_policy<KernelName, Factor>, Actions...>::distributed_task_t;
+		};
+
+		// runs the compute functors of a task in a host task on every node, every node processes the items of its chunk
+		template <typename... Actions>
+		class task_t<distributed_host_execution_policy, Actions...>
 		{
 		public:
-			using execution_policy_type = named_distributed_execution_policy<KernelName>;
+			using execution_policy_type = distributed_host_execution_policy;
 
 			static_assert(((traits::is_compute_task_v<Actions>)&&...), "task can only contain compute task functors");
 
@@ -52,9 +262,16 @@ namespace celerity::algorithm
 
 					static_assert(size_v<decltype(sequence(r))> == 1);
 
-					cgh.template parallel_for<KernelName>(d, *beg, [r](cl::sycl::item<Rank> item) {
-						item_context_type ctx{item};
-						invoke(sequence(r), ctx);
+					cgh.host_task(d, *beg, [r, d, offset = *beg](celerity::partition<Rank> part) {
+						const auto sr = part.get_subrange();
+
+						cl::sycl::id<Rank> id{};
+
+						for (size_t i = 0, n = sr.range.size(); i < n; ++i, id = next(id, sr.range))
+						{
+							item_context_type ctx{cl::sycl::detail::make_item(sr.offset + id, d, offset)};
+							invoke(sequence(r), ctx);
+						}
 					});
 				});
 			}
@@ -157,6 +374,60 @@ namespace celerity::algorithm
 			sequence<F> sequence_;
 		};
 
+		template <bool Blocking, typename F>
+		class task_t<parallel_master_execution_policy<Blocking>, F>
+		{
+		public:
+			static_assert(traits::is_master_task_v<F>, "task can only contain master task functors");
+
+			explicit task_t(F f) : sequence_(std::move(f)) {}
+
+			template <int Rank>
+			void operator()(distr_queue &q, iterator<Rank> beg, iterator<Rank> end) const
+			{
+				using namespace traits;
+				using namespace std;
+
+				const auto d = distance(beg, end);
+
+				q.submit(celerity::allow_by_ref, [seq = sequence_, d, beg](handler &cgh) {
+					const auto r = invoke(seq, cgh);
+
+					using first_kernel_type = first_result_t<decltype(r)>;
+					using item_context_type = decay_t<arg_type_t<first_kernel_type, 0>>;
+
+					cgh.host_task(celerity::on_master_node, [=]() {
+						parallel_for_each_index(d, *beg, [r](cl::sycl::item<Rank> item) {
+							item_context_type ctx{item};
+							invoke(sequence(r), ctx);
+						});
+					});
+				});
+
+				if constexpr (Blocking)
+				{
+					q.slow_full_sync();
+				}
+			}
+
+			void operator()(distr_queue &q) const
+			{
+				q.submit(celerity::allow_by_ref, [seq = sequence_](handler &cgh) {
+					cgh.host_task(celerity::on_master_node, std::invoke(seq, cgh));
+				});
+
+				if constexpr (Blocking)
+				{
+					q.slow_full_sync();
+				}
+			}
+
+			auto get_sequence() const { return sequence_; }
+
+		private:
+			sequence<F> sequence_;
+		};
+
 		template <typename ExecutionPolicy, typename T>
 		auto task(const task_t<ExecutionPolicy, T> &t)
 		{
@@ -213,6 +484,134 @@ namespace celerity::algorithm
 			return std::invoke(lhs, queue);
 		}
 
+		template <bool Blocking, typename F>
+		decltype(auto) operator|(task_t<parallel_master_execution_policy<Blocking>, F> lhs, celerity::distr_queue queue)
+		{
+			return std::invoke(lhs, queue);
+		}
+
+		// submits the master task f without blocking, the returned future receives the result of its host functor,
+		// other nodes never run the host functor, so their future<void> is ready right away and any other future
+		// holds a std::logic_error, as the result is only available on the master node
+		template <typename F>
+		auto submit_with_future(celerity::distr_queue q, const F &f)
+		{
+			using host_functor_type = std::invoke_result_t<F, celerity::handler &>;
+			using result_type = std::invoke_result_t<host_functor_type>;
+
+			const auto done = std::make_shared<std::promise<result_type>>();
+			auto result = done->get_future();
+
+			const auto t = task<non_blocking_master_execution_policy>([=](celerity::handler &cgh) {
+				const auto host_functor = f(cgh);
+
+				return [=]() {
+					try
+					{
+						if constexpr (std::is_void_v<result_type>)
+						{
+							host_functor();
+							done->set_value();
+						}
+						else
+						{
+							done->set_value(host_functor());
+						}
+					}
+					catch (...)
+					{
+						done->set_exception(std::current_exception());
+					}
+				};
+			});
+
+			t(q);
+
+			if (!is_master_node())
+			{
+				if constexpr (std::is_void_v<result_type>)
+				{
+					done->set_value();
+				}
+				else
+				{
+					done->set_exception(std::make_exception_ptr(std::logic_error("the result of a master task is only available on the master node")));
+				}
+			}
+
+			return result;
+		}
+
+		// the even share of node out of nodes of the rows (first dimension) of range
+		template <int Rank>
+		celerity::subrange<Rank> node_part(cl::sycl::range<Rank> range, size_t node, size_t nodes)
+		{
+			celerity::subrange<Rank> part{{}, range};
+
+			part.offset[0] = range[0] * node / nodes;
+			part.range[0] = range[0] * (node + 1) / nodes - part.offset[0];
+
+			return part;
+		}
+
+		// maps the chunk of a collective host task, which holds one index per node, to the nodes' shares of the rows of range,
+		// which starts at offset of the buffer
+		template <int Rank>
+		struct node_part_mapper
+		{
+			cl::sycl::range<Rank> range;
+			cl::sycl::id<Rank> offset{};
+
+			celerity::subrange<Rank> operator()(celerity::chunk<1> chnk) const
+			{
+				const auto first = node_part(range, chnk.offset[0], chnk.global_size[0]);
+				const auto last = node_part(range, chnk.offset[0] + chnk.range[0] - 1, chnk.global_size[0]);
+
+				auto part = first;
+				part.offset += offset;
+				part.range[0] = last.offset[0] + last.range[0] - first.offset[0];
+
+				return part;
+			}
+		};
+
+		// submits a collective host task, every node runs the host functor returned by f with its partition of the task
+		// and the returned future receives the result on this node, so no node depends on whether or when another one gets its future
+		template <typename F>
+		auto submit_collective_with_future(celerity::distr_queue q, const F &f)
+		{
+			using host_functor_type = std::invoke_result_t<F, celerity::handler &>;
+			using result_type = std::invoke_result_t<host_functor_type, celerity::experimental::collective_partition>;
+
+			const auto done = std::make_shared<std::promise<result_type>>();
+			auto result = done->get_future();
+
+			q.submit(celerity::allow_by_ref, [=](celerity::handler &cgh) {
+				const auto host_functor = f(cgh);
+
+				cgh.host_task(celerity::experimental::collective, [=](celerity::experimental::collective_partition part) {
+					try
+					{
+						if constexpr (std::is_void_v<result_type>)
+						{
+							host_functor(part);
+							done->set_value();
+						}
+						else
+						{
+							done->set_value(host_functor(part));
+						}
+					}
+					catch (...)
+					{
+						done->set_exception(std::current_exception());
+					}
+				});
+			});
+
+			return result;
+		}
+
 	} // namespace detail
 
 } // namespace celerity::algorithm
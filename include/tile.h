@@ -0,0 +1,237 @@
+#ifndef TILE_H
+#define TILE_H
+
+#include "sycl.h"
+#include "celerity_accessor_traits.h"
+
+#include <array>
+#include <algorithm>
+#include <type_traits>
+
+namespace celerity::algorithm
+{
+
+    template <typename Accessor, size_t... Extents>
+    class basic_chunk;
+
+    namespace detail
+    {
+
+        // values of a chunk around a work item which are recomputed by a fused producer
+        // instead of being read from a buffer (overlapped tiling)
+        template <typename T, size_t... Extents>
+        class tile
+        {
+        public:
+            using value_type = T;
+
+            static constexpr int rank = sizeof...(Extents);
+            static constexpr size_t size = (Extents * ...);
+
+            // evaluates f for every id of the chunk around item which lies inside the range of item,
+            // values outside of the range are default constructed: a chunk of a buffer cannot be read there either,
+            // so stencils have to discern the boundary of the range (see basic_chunk::discern) whether they read a tile or a buffer
+            template <typename F>
+            void fill(cl::sycl::item<rank> item, const F &f)
+            {
+                static_assert(std::is_default_constructible_v<T>, "tiles default construct the values outside of the range");
+
+                constexpr size_t extents[] = {Extents...};
+
+                const auto offset = item.get_offset();
+                const auto range = item.get_range();
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    auto id = item.get_id();
+                    auto in_range = true;
+                    auto rest = i;
+
+                    for (int d = rank - 1; d >= 0; --d)
+                    {
+                        const auto pos = static_cast<long>(id[d]) + static_cast<long>(rest % extents[d]) - static_cast<long>(extents[d] / 2);
+
+                        in_range = in_range && pos >= static_cast<long>(offset[d]) && pos < static_cast<long>(offset[d] + range[d]);
+
+                        id[d] = static_cast<size_t>(pos);
+                        rest /= extents[d];
+                    }
+
+                    values_[i] = in_range ? f(cl::sycl::detail::make_item(id, range, offset)) : T{};
+                }
+            }
+
+            const T *data() const { return values_; }
+
+        private:
+            T values_[size];
+        };
+
+        template <typename T, int Rank>
+        class tile_accessor
+        {
+        public:
+            template <size_t... Extents>
+            tile_accessor(const tile<T, Extents...> &t, cl::sycl::id<Rank> center)
+                : data_(t.data()), extents_(Extents...)
+            {
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    origin_[i] = center[i] - extents_[i] / 2;
+                }
+            }
+
+            // same wrap-around arithmetic as chunk, ids left of the origin map to the lower part of the tile
+            const T &operator[](cl::sycl::id<Rank> id) const
+            {
+                size_t linear_id = 0;
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    linear_id = linear_id * extents_[i] + (id[i] - origin_[i]);
+                }
+
+                return data_[linear_id];
+            }
+
+        private:
+            const T *data_;
+            cl::sycl::range<Rank> extents_;
+            cl::sycl::id<Rank> origin_;
+        };
+
+        // halo by which the kernels recomputed for a tile read beyond their own chunk,
+        // it is only non-zero while the command group of a tiled fusion is built
+        inline thread_local std::array<size_t, 3> tile_halo{};
+
+        template <typename Tile>
+        struct tile_halo_scope;
+
+        template <typename T, size_t... Extents>
+        struct tile_halo_scope<tile<T, Extents...>>
+        {
+            tile_halo_scope()
+            {
+                const size_t halo[] = {(Extents / 2)...};
+
+                for (size_t i = 0; i < sizeof...(Extents); ++i)
+                {
+                    tile_halo[i] += halo[i];
+                }
+            }
+
+            ~tile_halo_scope()
+            {
+                const size_t halo[] = {(Extents / 2)...};
+
+                for (size_t i = 0; i < sizeof...(Extents); ++i)
+                {
+                    tile_halo[i] -= halo[i];
+                }
+            }
+
+            tile_halo_scope(const tile_halo_scope &) = delete;
+            tile_halo_scope &operator=(const tile_halo_scope &) = delete;
+        };
+
+        template <int Rank>
+        bool has_tile_halo()
+        {
+            return std::any_of(tile_halo.begin(), tile_halo.begin() + Rank, [](size_t halo) { return halo != 0; });
+        }
+
+        // widens the chunk by the current tile halo before applying the range mapper,
+        // so the data a recomputing kernel reads for the halo is available on the node
+        template <int Rank, typename RangeMapper>
+        struct tiled_range_mapper
+        {
+            RangeMapper mapper;
+            std::array<size_t, 3> halo = tile_halo;
+
+            celerity::subrange<Rank> operator()(celerity::chunk<Rank> chnk) const
+            {
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    const auto low = std::min(chnk.offset[i], halo[i]);
+
+                    chnk.offset[i] -= low;
+                    chnk.range[i] = std::min(chnk.range[i] + low + halo[i], chnk.global_size[i] - chnk.offset[i]);
+                }
+
+                return mapper(chnk);
+            }
+        };
+
+        template <int Rank, typename RangeMapper>
+        auto tiled(RangeMapper mapper)
+        {
+            return tiled_range_mapper<Rank, RangeMapper>{mapper};
+        }
+
+    } // namespace detail
+
+    namespace traits
+    {
+
+        template <typename T>
+        struct is_tile : std::false_type
+        {
+        };
+
+        template <typename T, size_t... Extents>
+        struct is_tile<detail::tile<T, Extents...>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        inline constexpr bool is_tile_v = is_tile<T>::value;
+
+        template <typename Chunk>
+        struct tile_type;
+
+        template <typename Accessor, size_t... Extents>
+        struct tile_type<basic_chunk<Accessor, Extents...>>
+        {
+            using type = detail::tile<typename basic_chunk<Accessor, Extents...>::value_type, Extents...>;
+        };
+
+        template <typename Chunk>
+        using tile_type_t = typename tile_type<Chunk>::type;
+
+        // tiles live in private memory, they have no SYCL accessor target
+        template <typename T>
+        struct is_tile_accessor : std::false_type
+        {
+        };
+
+        template <typename T, int Rank>
+        struct is_tile_accessor<detail::tile_accessor<T, Rank>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        inline constexpr bool is_tile_accessor_v = is_tile_accessor<T>::value;
+
+        template <typename T, int Rank>
+        struct accessor_mode<detail::tile_accessor<T, Rank>>
+            : std::integral_constant<cl::sycl::access::mode, cl::sycl::access::mode::read>
+        {
+        };
+
+        template <typename T, int Rank>
+        struct accessor_rank<detail::tile_accessor<T, Rank>>
+            : std::integral_constant<int, Rank>
+        {
+        };
+
+        template <typename T, int Rank>
+        struct accessor_value_type<detail::tile_accessor<T, Rank>>
+        {
+            using type = T;
+        };
+
+    } // namespace traits
+
+} // namespace celerity::algorithm
+
+#endif // TILE_H
@@ -0,0 +1,131 @@
+#ifndef TIME_BLOCKING_H
+#define TIME_BLOCKING_H
+
+#include "accessors.h"
+#include "accessor_traits.h"
+#include "accessor_type.h"
+#include "tile.h"
+
+#include <utility>
+
+namespace celerity::algorithm
+{
+
+    namespace detail
+    {
+
+        // values of a stencil's input around a work item which are needed to apply the stencil Steps more times
+        template <size_t Steps, typename Chunk>
+        struct step_window;
+
+        template <size_t Steps, typename Accessor, size_t... Extents>
+        struct step_window<Steps, basic_chunk<Accessor, Extents...>>
+        {
+            using value_type = traits::accessor_value_type_t<Accessor>;
+
+            using chunk_type = basic_chunk<Accessor, (2 * Steps * (Extents / 2) + 1)...>;
+            using tile_type = tile<value_type, (2 * Steps * (Extents / 2) + 1)...>;
+        };
+
+        template <size_t Steps, typename Chunk>
+        using step_chunk_t = typename step_window<Steps, Chunk>::chunk_type;
+
+        template <size_t Steps, typename Chunk>
+        using step_tile_t = typename step_window<Steps, Chunk>::tile_type;
+
+        // evaluates the stencil for item, two-step recurrences additionally read the previous step one-to-one
+        template <typename Chunk, typename F, typename Prev, typename Curr, int Rank>
+        auto apply_step(const F &f, cl::sycl::item<Rank> item, cl::sycl::id<Rank> center, const Prev &prev, const Curr &curr)
+        {
+            using value_type = typename Chunk::value_type;
+
+            const tile_accessor<value_type, Rank> curr_acc{curr, center};
+
+            if constexpr (traits::arity_v<F> == 1)
+            {
+                return f(Chunk{item, curr_acc});
+            }
+            else
+            {
+                return f(tile_accessor<value_type, Rank>{prev, center}[item.get_id()], Chunk{item, curr_acc});
+            }
+        }
+
+        // curr holds the window of the current step around item, every step shrinks the window by the halo of the stencil
+        template <size_t Remaining, typename Chunk, typename F, typename Prev, typename Curr, int Rank>
+        auto advance(const F &f, cl::sycl::item<Rank> item, const Prev &prev, const Curr &curr)
+        {
+            if constexpr (Remaining == 1)
+            {
+                return apply_step<Chunk>(f, item, item.get_id(), prev, curr);
+            }
+            else
+            {
+                step_tile_t<Remaining - 1, Chunk> next;
+                next.fill(item, [&](cl::sycl::item<Rank> i) { return apply_step<Chunk>(f, i, item.get_id(), prev, curr); });
+
+                return advance<Remaining - 1, Chunk>(f, item, curr, next);
+            }
+        }
+
+    } // namespace detail
+
+    // applies the stencil f Steps times within a single kernel (temporal blocking):
+    // the returned functor reads its input with a halo Steps times as wide and recomputes
+    // the intermediate steps in private memory instead of writing them to a buffer.
+    //
+    // f is either T(const chunk<T, Extents...> &) or, for two-step recurrences like the wave equation,
+    // T(T prev, const chunk<T, Extents...> &curr), the result is then the Steps-th step after curr.
+    template <size_t Steps, typename F>
+    auto time_blocked(const F &f)
+    {
+        using namespace traits;
+
+        using chunk_type = std::decay_t<arg_type_t<F, arity_v<F> - 1>>;
+        using value_type = typename chunk_type::value_type;
+
+        static_assert(Steps > 0, "at least one step is required");
+        static_assert(arity_v<F> == 1 || arity_v<F> == 2, "only stencils with one or two inputs can be blocked");
+        static_assert(is_chunk_v<chunk_type>, "stencil must read the current step through a chunk");
+        static_assert(is_type_erased_view_v<chunk_type>, "intermediate steps are read from private memory, the chunk must not be statically typed");
+        static_assert(std::is_same_v<result_type_t<F>, value_type>, "stencil must return the element type of its input");
+
+        if constexpr (arity_v<F> == 1)
+        {
+            return [f](const detail::step_chunk_t<Steps, chunk_type> &in) {
+                detail::step_tile_t<Steps, chunk_type> curr;
+                curr.fill(in.item(), [&](const auto &i) { return in.get(i.get_id()); });
+
+                return detail::advance<Steps, chunk_type>(f, in.item(), curr, curr);
+            };
+        }
+        else
+        {
+            static_assert(std::is_same_v<std::decay_t<arg_type_t<F, 0>>, value_type>, "previous step must be read one-to-one");
+
+            return [f](const detail::step_chunk_t<Steps - 1, chunk_type> &prev_in, const detail::step_chunk_t<Steps, chunk_type> &in) {
+                detail::step_tile_t<Steps - 1, chunk_type> prev;
+                prev.fill(in.item(), [&](const auto &i) { return prev_in.get(i.get_id()); });
+
+                detail::step_tile_t<Steps, chunk_type> curr;
+                curr.fill(in.item(), [&](const auto &i) { return in.get(i.get_id()); });
+
+                return detail::advance<Steps, chunk_type>(f, in.item(), prev, curr);
+            };
+        }
+    }
+
+    // for two-step recurrences: the stencils advancing prev and curr by Steps - 1 and by Steps steps,
+    // their results are prev and curr of the next blocked submission, so blocked submissions can be chained
+    template <size_t Steps, typename F>
+    auto time_blocked_pair(const F &f)
+    {
+        static_assert(Steps > 1, "the step before the first blocked step is curr itself");
+        static_assert(traits::arity_v<F> == 2, "only two-step recurrences read the previous step");
+
+        return std::pair{time_blocked<Steps - 1>(f), time_blocked<Steps>(f)};
+    }
+
+} // namespace celerity::algorithm
+
+#endif // TIME_BLOCKING_H
@@ -42,7 +42,7 @@ namespace celerity::algorithm
             explicit transient_buffer(cl::sycl::range<Rank> range)
                 : range_(range), id_(curr_id++) {}
 
-            template <cl::sycl::access::mode Mode, typename RangeMapper>
+            template <cl::sycl::access::mode Mode, cl::sycl::access::target Target = cl::sycl::access::target::global_buffer, typename RangeMapper>
             auto get_access(handler &cgh, RangeMapper)
             {
                 return transient_accessor<T, Rank, Mode>{};
@@ -95,6 +95,13 @@ namespace celerity::algorithm
             return false;
         }
 
+        template <typename ElementTypeA, int RankA,
+                  typename ElementTypeB, int RankB>
+        bool are_equal(transient_buffer<ElementTypeA, RankA> a, transient_buffer<ElementTypeB, RankB> b)
+        {
+            return false;
+        }
+
         template <typename ElementType, int Rank>
         bool are_equal(transient_buffer<ElementType, Rank> a, transient_buffer<ElementType, Rank> b)
         {
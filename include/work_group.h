@@ -0,0 +1,386 @@
+#ifndef WORK_GROUP_H
+#define WORK_GROUP_H
+
+#include "celerity_helper.h"
+#include "any_accessor.h"
+
+#include <array>
+#include <algorithm>
+
+namespace celerity::algorithm
+{
+
+    namespace detail
+    {
+
+        template <typename T, int Rank>
+        using local_accessor = celerity::local_accessor<T, Rank>;
+
+        // the nd_item of a work item of a task which is launched in work groups
+        template <int Rank>
+        class work_group
+        {
+        public:
+            explicit work_group(cl::sycl::nd_item<Rank> item)
+                : item_(item) {}
+
+            cl::sycl::id<Rank> get_local_id() const { return item_.get_local_id(); }
+            cl::sycl::range<Rank> get_local_range() const { return item_.get_local_range(); }
+            cl::sycl::id<Rank> get_group_id() const { return item_.get_group().get_id(); }
+
+            // row-major index of the work item in its group
+            size_t get_local_linear_id() const { return item_.get_local_linear_id(); }
+
+            // groups which exchange data through global memory have to fence it as well
+            void barrier(cl::sycl::access::fence_space space = cl::sycl::access::fence_space::local_space) const { item_.barrier(space); }
+
+        private:
+            cl::sycl::nd_item<Rank> item_;
+        };
+
+        // size of the work groups of the task whose command group is currently built,
+        // it is only set while the command group of a task launched in work groups is built
+        inline thread_local std::array<size_t, 3> work_group_size{};
+
+        template <int Rank>
+        struct work_group_scope
+        {
+            explicit work_group_scope(cl::sycl::range<Rank> local_range)
+            {
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    work_group_size[i] = local_range[i];
+                }
+            }
+
+            ~work_group_scope()
+            {
+                work_group_size = {};
+            }
+
+            work_group_scope(const work_group_scope &) = delete;
+            work_group_scope &operator=(const work_group_scope &) = delete;
+        };
+
+        template <int Rank>
+        cl::sycl::range<Rank> current_work_group_size()
+        {
+            cl::sycl::range<Rank> local_range{};
+
+            for (auto i = 0; i < Rank; ++i)
+            {
+                local_range[i] = work_group_size[i];
+            }
+
+            return local_range;
+        }
+
+        // range rounded up to whole work groups of local_range
+        template <int Rank>
+        cl::sycl::range<Rank> padded_range(cl::sycl::range<Rank> range, cl::sycl::range<Rank> local_range)
+        {
+            for (auto i = 0; i < Rank; ++i)
+            {
+                range[i] = (range[i] + local_range[i] - 1) / local_range[i] * local_range[i];
+            }
+
+            return range;
+        }
+
+        // maps a chunk of the work items of a launch in work groups to the ids of their groups,
+        // for buffers holding one element per work group
+        template <int Rank>
+        struct work_group_mapper
+        {
+            cl::sycl::id<Rank> launch_offset;
+            cl::sycl::range<Rank> local_range;
+
+            celerity::subrange<Rank> operator()(celerity::chunk<Rank> chnk) const
+            {
+                celerity::subrange<Rank> groups{};
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    groups.offset[i] = (chnk.offset[i] - launch_offset[i]) / local_range[i];
+                    groups.range[i] = (chnk.range[i] + local_range[i] - 1) / local_range[i];
+                }
+
+                return groups;
+            }
+        };
+
+        struct no_slice_stage
+        {
+        };
+
+        // upper bound of the local memory the slices of one view take per work group
+        constexpr size_t max_staged_slice_bytes = 16 * 1024;
+
+        // stages the slices of a work group through local memory: the group loads all of its slices along Dim
+        // cooperatively before the kernel runs, so every element of them is read from global memory once per group
+        // instead of once per work item, and reading them afterwards needs no synchronization
+        template <typename T, int Rank, size_t Dim>
+        class slice_stage
+        {
+        public:
+            slice_stage() = default;
+
+            slice_stage(const local_accessor<T, Rank> &tile, const work_group<Rank> *group)
+                : tile_(&tile), group_(group) {}
+
+            // work items which are not launched in a work group, or evaluated outside of it like
+            // the recomputed halo of a fused kernel, read the slice from global memory
+            bool is_staged() const { return group_ != nullptr; }
+
+            static cl::sycl::range<Rank> tile_range(cl::sycl::range<Rank> local_range, cl::sycl::range<Rank> range)
+            {
+                local_range[Dim] = range[Dim];
+                return local_range;
+            }
+
+            // slices longer than the local memory allows are read from global memory
+            static bool fits(cl::sycl::range<Rank> local_range, cl::sycl::range<Rank> range)
+            {
+                return count(tile_range(local_range, range)) * sizeof(T) <= max_staged_slice_bytes;
+            }
+
+            // the local memory the proxy allocates, a single element for slices which do not fit
+            static cl::sycl::range<Rank> allocated_range(cl::sycl::range<Rank> local_range, cl::sycl::range<Rank> range)
+            {
+                if (fits(local_range, range))
+                {
+                    return tile_range(local_range, range);
+                }
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    local_range[i] = 1;
+                }
+
+                return local_range;
+            }
+
+            // must be called by all work items of the group, id is the id of the calling work item
+            template <typename Accessor>
+            void load(const Accessor &acc, cl::sycl::id<Rank> id, cl::sycl::range<Rank> range) const
+            {
+                const auto local_id = group_->get_local_id();
+                const auto local_range = group_->get_local_range();
+                const auto tile_size = tile_range(local_range, range);
+
+                // the tile may still be read by the work items of a view staged before, e.g. by a kernel reading the same input twice
+                group_->barrier();
+
+                auto origin = id;
+                size_t local_linear_id = 0;
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    origin[i] = static_cast<size_t>(i) == Dim ? 0 : id[i] - local_id[i];
+                    local_linear_id = local_linear_id * local_range[i] + local_id[i];
+                }
+
+                for (auto tile_id = next(cl::sycl::id<Rank>{}, tile_size, static_cast<int>(local_linear_id));
+                     tile_id[0] < tile_size[0];
+                     tile_id = next(tile_id, tile_size, static_cast<int>(count(local_range))))
+                {
+                    auto global_id = origin;
+                    auto inside = true;
+
+                    for (auto i = 0; i < Rank; ++i)
+                    {
+                        global_id[i] += tile_id[i];
+                        inside = inside && global_id[i] < range[i];
+                    }
+
+                    (*tile_)[tile_id] = inside ? acc[global_id] : T{};
+                }
+
+                group_->barrier();
+            }
+
+            T get(int pos) const
+            {
+                auto tile_id = group_->get_local_id();
+                tile_id[Dim] = pos;
+
+                return (*tile_)[tile_id];
+            }
+
+        private:
+            const local_accessor<T, Rank> *tile_ = nullptr;
+            const work_group<Rank> *group_ = nullptr;
+        };
+
+        template <typename Accessor, size_t Dim, bool Transpose, typename = void>
+        struct slice_stage_type
+        {
+            using type = no_slice_stage;
+        };
+
+        // only slices of statically typed views know the rank of their buffer at compile time
+        template <typename Accessor, size_t Dim>
+        struct slice_stage_type<Accessor, Dim, false, std::enable_if_t<!traits::is_any_accessor_v<Accessor>>>
+        {
+            using type = slice_stage<traits::accessor_value_type_t<Accessor>, traits::accessor_rank_v<Accessor>, Dim>;
+        };
+
+        template <typename Accessor, size_t Dim, bool Transpose>
+        using slice_stage_t = typename slice_stage_type<Accessor, Dim, Transpose>::type;
+
+        struct no_chunk_stage
+        {
+        };
+
+        // stages the elements a work group reads through its chunks in local memory: the tile of the group
+        // plus a halo of Extents / 2 on every side is loaded cooperatively once, every neighbour read of the
+        // work items is then served from local memory instead of reading the element from global memory again
+        template <typename T, int Rank, size_t... Extents>
+        class chunk_stage
+        {
+        public:
+            chunk_stage() = default;
+
+            chunk_stage(const local_accessor<T, Rank> &tile, const work_group<Rank> *group)
+                : tile_(&tile), group_(group) {}
+
+            bool is_staged() const { return group_ != nullptr; }
+
+            static cl::sycl::range<Rank> tile_range(cl::sycl::range<Rank> local_range)
+            {
+                const cl::sycl::range<Rank> halo{(Extents / 2)...};
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    local_range[i] += 2 * halo[i];
+                }
+
+                return local_range;
+            }
+
+            // must be called by all work items of the group, id is the id of the calling work item,
+            // elements outside of range are staged as T{}
+            template <typename Accessor>
+            void load(const Accessor &acc, cl::sycl::id<Rank> id, cl::sycl::range<Rank> range)
+            {
+                const cl::sycl::id<Rank> halo{(Extents / 2)...};
+
+                const auto local_id = group_->get_local_id();
+                const auto local_range = group_->get_local_range();
+                const auto tile_size = tile_range(local_range);
+
+                // the tile may still be read by the work items of a view staged before, e.g. by a kernel reading the same input twice
+                group_->barrier();
+
+                size_t local_linear_id = 0;
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    origin_[i] = id[i] - local_id[i];
+                    local_linear_id = local_linear_id * local_range[i] + local_id[i];
+                }
+
+                for (auto tile_id = next(cl::sycl::id<Rank>{}, tile_size, static_cast<int>(local_linear_id));
+                     tile_id[0] < tile_size[0];
+                     tile_id = next(tile_id, tile_size, static_cast<int>(count(local_range))))
+                {
+                    auto global_id = origin_;
+                    auto inside = true;
+
+                    for (auto i = 0; i < Rank; ++i)
+                    {
+                        const auto g = static_cast<long>(origin_[i] + tile_id[i]) - static_cast<long>(halo[i]);
+
+                        inside = inside && g >= 0 && g < static_cast<long>(range[i]);
+                        global_id[i] = inside ? static_cast<size_t>(g) : 0;
+                    }
+
+                    (*tile_)[tile_id] = inside ? acc[global_id] : T{};
+                }
+
+                group_->barrier();
+            }
+
+            // ids outside of the tile of the group are read from global memory
+            template <typename Accessor>
+            T get(const Accessor &acc, cl::sycl::id<Rank> id) const
+            {
+                const cl::sycl::id<Rank> halo{(Extents / 2)...};
+                const auto tile_size = tile_range(group_->get_local_range());
+
+                auto tile_id = id;
+
+                for (auto i = 0; i < Rank; ++i)
+                {
+                    const auto t = static_cast<long>(id[i] + halo[i]) - static_cast<long>(origin_[i]);
+
+                    if (t < 0 || t >= static_cast<long>(tile_size[i]))
+                    {
+                        return acc[id];
+                    }
+
+                    tile_id[i] = static_cast<size_t>(t);
+                }
+
+                return (*tile_)[tile_id];
+            }
+
+        private:
+            const local_accessor<T, Rank> *tile_ = nullptr;
+            const work_group<Rank> *group_ = nullptr;
+            cl::sycl::id<Rank> origin_{};
+        };
+
+        template <typename Accessor, typename = void, size_t... Extents>
+        struct chunk_stage_type
+        {
+            using type = no_chunk_stage;
+        };
+
+        template <typename Accessor, size_t... Extents>
+        struct chunk_stage_type<Accessor, std::enable_if_t<!traits::is_any_accessor_v<Accessor>>, Extents...>
+        {
+            using type = chunk_stage<traits::accessor_value_type_t<Accessor>, traits::accessor_rank_v<Accessor>, Extents...>;
+        };
+
+        template <typename Accessor, size_t... Extents>
+        using chunk_stage_t = typename chunk_stage_type<Accessor, void, Extents...>::type;
+
+    } // namespace detail
+
+    // an item which knows the work group it is evaluated in, kernels taking it instead of a cl::sycl::item
+    // can synchronize with their group and share local memory when the task is launched in work groups
+    template <int Rank>
+    class group_item
+    {
+    public:
+        group_item(cl::sycl::item<Rank> item, const detail::work_group<Rank> *group = nullptr)
+            : item_(item), group_(group) {}
+
+        operator cl::sycl::item<Rank>() const { return item_; }
+
+        cl::sycl::item<Rank> get_item() const { return item_; }
+        cl::sycl::id<Rank> get_id() const { return item_.get_id(); }
+        size_t get_id(int dimension) const { return item_.get_id(dimension); }
+        size_t operator[](int dimension) const { return item_[dimension]; }
+        cl::sycl::range<Rank> get_range() const { return item_.get_range(); }
+
+        // false if the task is not launched in work groups, or for elements recomputed for the halo of a tile,
+        // which are evaluated outside of any group
+        bool has_group() const { return group_ != nullptr; }
+
+        cl::sycl::id<Rank> get_local_id() const { return group_->get_local_id(); }
+        cl::sycl::range<Rank> get_local_range() const { return group_->get_local_range(); }
+        cl::sycl::id<Rank> get_group_id() const { return group_->get_group_id(); }
+
+        // must be reached by all work items of the group
+        void barrier(cl::sycl::access::fence_space space = cl::sycl::access::fence_space::local_space) const { group_->barrier(space); }
+
+    private:
+        cl::sycl::item<Rank> item_;
+        const detail::work_group<Rank> *group_;
+    };
+
+} // namespace celerity::algorithm
+
+#endif // WORK_GROUP_H
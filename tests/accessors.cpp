@@ -6,6 +6,7 @@
 
 #include "utils.h"
 #include "../include/actions.h"
+#include "../include/buffer_traits.h"
 
 using namespace celerity;
 using namespace celerity::algorithm;
@@ -470,6 +471,87 @@ SCENARIO("accessing the entire buffer", "[accessors::all]")
     }
 }
 
+SCENARIO("accessing statically typed views", "[accessors::device]")
+{
+    distr_queue q;
+
+    using t = traits::buffer_traits<int, 2>;
+
+    static_assert(!traits::is_type_erased_view_v<t::device_slice<0>>);
+    static_assert(!traits::is_type_erased_view_v<t::device_chunk<3, 3>>);
+    static_assert(!traits::is_type_erased_view_v<t::device_all>);
+    static_assert(traits::is_type_erased_view_v<slice_i<0>>);
+
+    GIVEN("Two two-dimensional buffers of 16x16 representing the identity matrix times 3 and times 5")
+    {
+        constexpr auto rank = 16;
+
+        buffer<int, 2> buf_a({rank, rank});
+        buffer<int, 2> buf_b({rank, rank});
+
+        generate<class gen_identity_3>(q, buf_a, [](cl::sycl::item<2> i) { return static_cast<int>(i[0] == i[1]) * 3; });
+        generate<class gen_identity_5>(q, buf_b, [](cl::sycl::item<2> i) { return static_cast<int>(i[0] == i[1]) * 5; });
+
+        WHEN("multiplying using std::inner_product over device slices")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform<class matrix_mul_device>(q, buf_a, buf_b, buf_c,
+                                               [](const t::device_slice<1> &a, const t::device_slice<0> &b) {
+                                                   return std::inner_product(begin(a), end(a), begin(b), 0);
+                                               });
+
+            THEN("the result is the identity matrix times 15")
+            {
+                const auto r = copy_to_host(q, buf_c);
+
+                for (size_t i = 0; i < rank; ++i)
+                {
+                    for (size_t j = 0; j < rank; ++j)
+                    {
+                        REQUIRE(r[i * rank + j] == (i == j) * 15);
+                    }
+                }
+            }
+        }
+
+        WHEN("summing chunks of 3x3 of device memory")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform<class sum_chunk_device>(q, buf_a, buf_c, [](const t::device_chunk<3, 3> &c) {
+                return c.discern(0, [&]() { return std::accumulate(begin(c), end(c), 0); });
+            });
+
+            THEN("inner elements on the diagonal are 9 and their left neighbours are 6")
+            {
+                const auto r = copy_to_host(q, buf_c);
+
+                for (size_t i = 2; i < rank - 1; ++i)
+                {
+                    REQUIRE(r[i * rank + i] == 9);
+                    REQUIRE(r[i * rank + i - 1] == 6);
+                }
+            }
+        }
+
+        WHEN("reading the first element of the entire buffer")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform<class set_first_device>(q, buf_b, buf_c, [](const t::device_all &x) {
+                return x[{0, 0}];
+            });
+
+            THEN("each element is equal to 5")
+            {
+                const auto r = copy_to_host(q, buf_c);
+                REQUIRE(elements_equal_to<5>(r));
+            }
+        }
+    }
+}
+
 SCENARIO("using any_accessor<T>", "[accessors::any_accessor]")
 {
     distr_queue q;
@@ -4,7 +4,13 @@
 
 #include "utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <numeric>
+#include <stdexcept>
 
 using namespace celerity;
 using namespace celerity::algorithm;
@@ -52,6 +58,158 @@ SCENARIO("copying a buffer", "[celerity::algorithm]")
         }
     }
 
+    GIVEN("A two-dimensional buffer of 10x4 ascending numbers")
+    {
+        const auto src = ascending_elements(40);
+
+        buffer<int, 2> buf(src.data(), {10, 4});
+
+        WHEN("streaming it to the host in blocks of 3 rows")
+        {
+            std::vector<celerity::subrange<2>> blocks;
+            std::vector<int> r;
+
+            copy(master_blocking(q), begin(buf), end(buf), [&](celerity::subrange<2> block, const host_block<int, 2> &data) {
+                blocks.push_back(block);
+                data.copy_to(std::back_inserter(r));
+            }, 3);
+
+            THEN("the sink receives all blocks in order with a shorter last block")
+            {
+                REQUIRE(blocks.size() == 4);
+                REQUIRE(blocks[1].offset == cl::sycl::id<2>{3, 0});
+                REQUIRE(blocks[3].range == cl::sycl::range<2>{1, 4});
+                REQUIRE(r == src);
+            }
+        }
+
+        WHEN("streaming rows 2 to 9 into a vector of doubles in blocks of 2 rows")
+        {
+            auto beg = begin(buf);
+            beg += cl::sycl::id<2>{2, 0};
+
+            std::vector<double> r(32);
+            copy(master_blocking(q), beg, end(buf), r.begin(), 2);
+
+            THEN("the elements of the rows are converted in row-major order")
+            {
+                REQUIRE(std::equal(begin(r), end(r), begin(src) + 8));
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 300x200 floats")
+    {
+        const auto src = indexed_elements(300 * 200, [](size_t i) { return static_cast<float>(i) + 0.5f; });
+
+        buffer<float, 2> buf(src.data(), {300, 200});
+
+        WHEN("copying asynchronously to a vector of floats")
+        {
+            std::vector<float> r(src.size());
+            auto copied = copy(master_async(q), buf, r.data());
+
+            THEN("the vector holds the elements once the future is ready")
+            {
+                copied.get();
+                REQUIRE(r == src);
+            }
+        }
+
+        WHEN("copying to a vector of doubles")
+        {
+            std::vector<double> r(src.size());
+            copy(master_blocking(q), buf, r.data());
+
+            THEN("every element is converted")
+            {
+                REQUIRE(std::equal(begin(src), end(src), begin(r), [](float a, double b) { return static_cast<double>(a) == b; }));
+            }
+        }
+
+        WHEN("copying to a vector of ints in reverse order")
+        {
+            std::vector<int> r(src.size());
+            copy(master_blocking(q), buf, r.rbegin());
+
+            THEN("every element is truncated and written to its mirrored position")
+            {
+                std::vector<int> expected(src.rbegin(), src.rend());
+                REQUIRE(r == expected);
+            }
+        }
+
+        WHEN("copying through a back inserter")
+        {
+            std::vector<float> r;
+            copy(master_blocking(q), buf, std::back_inserter(r));
+
+            THEN("the elements are appended in order")
+            {
+                REQUIRE(r == src);
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 8x6 0s")
+    {
+        buffer<int, 2> buf({8, 6});
+
+        fill<class fill_copy_in>(q, buf, 0);
+
+        WHEN("copying a host row into the last row on every node")
+        {
+            const std::vector<int> row{1, 2, 3, 4, 5, 6};
+
+            copy(distr<class copy_in_row>(q), row.data(), buf, skip<2>({7, 0}), take<2>({1, 6}));
+
+            THEN("only the last row is replaced")
+            {
+                const auto r = copy_to_host(q, buf);
+
+                REQUIRE(elements_equal_to<0>(begin(r), begin(r) + 42));
+                REQUIRE(std::equal(begin(row), end(row), begin(r) + 42));
+            }
+        }
+
+        WHEN("overwriting the host row right after copying it into the first row")
+        {
+            std::vector<int> row{1, 2, 3, 4, 5, 6};
+
+            copy(distr<class copy_in_refill>(q), row.data(), buf, skip<2>({0, 0}), take<2>({1, 6}));
+            std::fill(begin(row), end(row), 9);
+
+            THEN("the buffer holds the row as it was when copy was called")
+            {
+                const auto r = copy_to_host(q, buf);
+
+                REQUIRE(std::equal(begin(r), begin(r) + 6, std::vector<int>{1, 2, 3, 4, 5, 6}.begin()));
+                REQUIRE(elements_equal_to<0>(begin(r) + 6, end(r)));
+            }
+        }
+
+        WHEN("copying converted host values into the inner 6x4 block on the master")
+        {
+            const auto block = indexed_elements(24, [](size_t i) { return static_cast<double>(i + 1); });
+
+            copy(master_blocking(q), block.begin(), buf, skip<2>({1, 1}), take<2>({6, 4}));
+
+            THEN("the block is written in row-major order and the border stays 0")
+            {
+                const auto r = copy_to_host(q, buf);
+
+                for (size_t y = 0; y < 8; ++y)
+                {
+                    for (size_t x = 0; x < 6; ++x)
+                    {
+                        const auto inner = y >= 1 && y < 7 && x >= 1 && x < 5;
+                        REQUIRE(r[y * 6 + x] == (inner ? static_cast<int>((y - 1) * 4 + (x - 1) + 1) : 0));
+                    }
+                }
+            }
+        }
+    }
+
     GIVEN("A three-dimensional buffer of 10x10x10 1s")
     {
         constexpr auto rank = 10;
@@ -71,6 +229,319 @@ SCENARIO("copying a buffer", "[celerity::algorithm]")
     }
 }
 
+SCENARIO("reading and writing binary files", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    const auto path = std::string{"celerity_algorithm_test.bin"};
+
+    GIVEN("A two-dimensional buffer of 7x5 increasing numbers")
+    {
+        const auto src = indexed_elements(7 * 5, [](size_t i) { return static_cast<float>(i) + 0.5f; });
+
+        buffer<float, 2> buf(src.data(), {7, 5});
+
+        WHEN("writing it to a file")
+        {
+            to_file(q, buf, path).get();
+
+            THEN("the file holds the elements in row-major order")
+            {
+                std::vector<float> r(src.size());
+                std::ifstream{path, std::ios::binary}.read(reinterpret_cast<char *>(r.data()), r.size() * sizeof(float));
+
+                REQUIRE(r == src);
+            }
+
+            AND_WHEN("reading the file into a new buffer")
+            {
+                auto [in, read] = from_file<float>(q, path, cl::sycl::range<2>{7, 5});
+
+                THEN("the buffer equals the source")
+                {
+                    REQUIRE_NOTHROW(read.get());
+
+                    std::vector<float> r(src.size());
+                    copy(master_blocking(q), in, r.data());
+
+                    REQUIRE(r == src);
+                }
+            }
+
+            AND_WHEN("transforming the file into another file in a pipeline")
+            {
+                const auto out_path = std::string{"celerity_algorithm_test_out.bin"};
+
+                auto out = from_file<float>(path, cl::sycl::range<2>{7, 5}) | transform<class file_pipeline_add>([](float x) { return x + 1.f; }) | to_file(out_path) | submit_to(q);
+                q.slow_full_sync();
+
+                THEN("the file holds the transformed elements and the result buffer is returned")
+                {
+                    std::vector<float> expected(src.size());
+                    std::transform(begin(src), end(src), begin(expected), [](float x) { return x + 1.f; });
+
+                    std::vector<float> r(src.size());
+                    std::ifstream{out_path, std::ios::binary}.read(reinterpret_cast<char *>(r.data()), r.size() * sizeof(float));
+
+                    REQUIRE(r == expected);
+
+                    std::vector<float> b(src.size());
+                    copy(master_blocking(q), out, b.data());
+
+                    REQUIRE(b == expected);
+                }
+
+                std::remove(out_path.c_str());
+            }
+        }
+
+        WHEN("reading a file which does not exist")
+        {
+            auto [in, read] = from_file<float>(q, "celerity_algorithm_missing.bin", cl::sycl::range<2>{7, 5});
+
+            THEN("every node gets the error through the future")
+            {
+                REQUIRE_THROWS_AS(read.get(), std::runtime_error);
+            }
+        }
+
+        WHEN("writing to a file in a directory which does not exist")
+        {
+            auto written = to_file(q, buf, "celerity_algorithm_missing/out.bin");
+
+            THEN("every node gets the error through the future")
+            {
+                REQUIRE_THROWS_AS(written.get(), std::runtime_error);
+            }
+        }
+
+        WHEN("writing rows 3 to 6 to a file")
+        {
+            auto beg = begin(buf);
+            beg += cl::sycl::id<2>{3, 0};
+
+            to_file(q, beg, end(buf), path).get();
+
+            THEN("the file holds only these rows")
+            {
+                std::ifstream file{path, std::ios::binary | std::ios::ate};
+                REQUIRE(file.tellg() == static_cast<std::streamoff>(20 * sizeof(float)));
+
+                std::vector<float> r(20);
+                file.seekg(0).read(reinterpret_cast<char *>(r.data()), r.size() * sizeof(float));
+
+                REQUIRE(std::equal(begin(r), end(r), begin(src) + 15));
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+SCENARIO("iterating a buffer on the master with all host threads", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A two-dimensional buffer of 300x200 increasing numbers")
+    {
+        const auto src = ascending_elements(300 * 200);
+
+        buffer<int, 2> buf(src.data(), {300, 200});
+
+        WHEN("visiting every element")
+        {
+            std::vector<std::atomic<int>> visits(src.size());
+            std::atomic<bool> matching{true};
+
+            for_each(master_parallel_blocking(q), buf, [&](cl::sycl::item<2> item, int x) {
+                const auto i = item.get_linear_id();
+
+                visits[i]++;
+                matching = matching && x == src[i];
+            });
+
+            THEN("every element is visited once with its own item")
+            {
+                REQUIRE(matching);
+                REQUIRE(std::all_of(begin(visits), end(visits), [](const std::atomic<int> &v) { return v == 1; }));
+            }
+        }
+
+        WHEN("visiting the rows 100 to 299")
+        {
+            auto beg = begin(buf);
+            beg += cl::sycl::id<2>{100, 0};
+
+            std::atomic<size_t> visited{0};
+            std::atomic<bool> in_range{true};
+
+            for_each(master_parallel_blocking(q), beg, end(buf), [&](cl::sycl::item<2> item, int x) {
+                visited++;
+                in_range = in_range && item.get_id()[0] >= 100 && x == static_cast<int>(item.get_id()[0] * 200 + item.get_id()[1]);
+            });
+
+            THEN("only the elements of these rows are visited")
+            {
+                REQUIRE(in_range);
+                REQUIRE(visited == 200 * 200);
+            }
+        }
+    }
+}
+
+SCENARIO("running host functors on the chunks of every node", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A two-dimensional buffer of 10x8 increasing numbers")
+    {
+        const auto src = ascending_elements(10 * 8);
+
+        buffer<int, 2> buf(src.data(), {10, 8});
+
+        WHEN("adding the row index to every element on the host")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform(distr_host(q), buf, buf_out, [](cl::sycl::item<2> item, int x) { return x + static_cast<int>(item.get_id()[0]); });
+
+            THEN("every element is increased by its row index")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == src[i] + static_cast<int>(i / 8));
+                }
+            }
+        }
+
+        WHEN("visiting every element on the host")
+        {
+            std::vector<std::atomic<int>> visits(src.size());
+            std::atomic<bool> matching{true};
+
+            for_each(distr_host(q), buf, [&](cl::sycl::item<2> item, int x) {
+                const auto i = item.get_linear_id();
+
+                visits[i]++;
+                matching = matching && x == src[i];
+            });
+
+            THEN("every element is visited once with its own item")
+            {
+                REQUIRE(matching);
+                REQUIRE(std::all_of(begin(visits), end(visits), [](const std::atomic<int> &v) { return v == 1; }));
+            }
+        }
+    }
+}
+
+SCENARIO("reading parts of buffers in master tasks", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A two-dimensional buffer of 8x6 increasing numbers and a one-dimensional buffer of ten 1s")
+    {
+        const auto src = ascending_elements(8 * 6);
+
+        buffer<int, 2> buf(src.data(), {8, 6});
+        buffer<int, 1> ones(cl::sycl::range<1>{10});
+
+        fill<class fill_master_ones>(q, ones, 1);
+
+        WHEN("reading the rows 2 and 3")
+        {
+            std::vector<int> rows;
+            cl::sycl::range<2> range{0, 0};
+
+            master_task(master(q), subrange_of(buf, skip<2>({2, 0}), take<2>({2, 6})), [&](algorithm::all<int, 2> r) {
+                range = r.get_range();
+                std::copy(begin(r), end(r), std::back_inserter(rows));
+            });
+
+            q.slow_full_sync();
+
+            THEN("the view spans only these rows")
+            {
+                REQUIRE(range == cl::sycl::range<2>{2, 6});
+                REQUIRE(std::equal(begin(rows), end(rows), begin(src) + 12, begin(src) + 24));
+            }
+        }
+
+        WHEN("reading the rows 2 and 3 in a master task returning a future")
+        {
+            std::vector<int> rows;
+            cl::sycl::range<2> range{0, 0};
+
+            auto done = master_task(master_async(q), subrange_of(buf, skip<2>({2, 0}), take<2>({2, 6})), [&](algorithm::all<int, 2> r) {
+                range = r.get_range();
+                std::copy(begin(r), end(r), std::back_inserter(rows));
+            });
+
+            done.wait();
+
+            THEN("the view spans only these rows once the future is ready")
+            {
+                REQUIRE(range == cl::sycl::range<2>{2, 6});
+                REQUIRE(std::equal(begin(rows), end(rows), begin(src) + 12, begin(src) + 24));
+            }
+        }
+
+        WHEN("reading the rows 2 and 3 in a blocking master task with the parallel policy")
+        {
+            std::vector<int> rows;
+
+            master_task(master_parallel_blocking(q), subrange_of(buf, skip<2>({2, 0}), take<2>({2, 6})), [&](algorithm::all<int, 2> r) {
+                std::copy(begin(r), end(r), std::back_inserter(rows));
+            });
+
+            THEN("the rows are read once the call returns")
+            {
+                REQUIRE(std::equal(begin(rows), end(rows), begin(src) + 12, begin(src) + 24));
+            }
+        }
+
+        WHEN("reading the inner 2x2 block of the first and the whole second buffer")
+        {
+            auto sum = 0;
+
+            master_task(master(q), pack(subrange_of(buf, skip<2>({3, 2}), take<2>({2, 2})), ones), [&](algorithm::all<int, 2> block, algorithm::all<int, 1> o) {
+                sum = std::accumulate(begin(block), end(block), 0) + std::accumulate(begin(o), end(o), 0);
+            });
+
+            q.slow_full_sync();
+
+            THEN("the elements of the block and the second buffer are summed up")
+            {
+                REQUIRE(sum == 20 + 21 + 26 + 27 + 10);
+            }
+        }
+    }
+
+    GIVEN("A master task returning a value")
+    {
+        WHEN("submitting it with a future")
+        {
+            auto result = algorithm::detail::submit_with_future(q, [](celerity::handler &) {
+                return []() { return 42; };
+            });
+
+            THEN("the future holds the value on the master node and an error on every other node")
+            {
+                if (is_master_node())
+                {
+                    REQUIRE(result.get() == 42);
+                }
+                else
+                {
+                    REQUIRE_THROWS_AS(result.get(), std::logic_error);
+                }
+            }
+        }
+    }
+}
+
 SCENARIO("filling a buffer", "[celerity::algorithm]")
 {
     distr_queue q;
@@ -235,6 +706,43 @@ SCENARIO("transforming a buffer", "[celerity::algorithm]")
         }
     }
 
+    GIVEN("A two-dimensional buffer of 12x8 1s")
+    {
+        buffer<int, 2> buf({12, 8});
+
+        fill<class fill_12x8>(q, buf, 1);
+
+        WHEN("adding the linear index to all elements in work groups of 4x4")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform(distr<class add_id_wg, 4, 4>(q), buf, buf_out, [](cl::sycl::item<2> i, int x) { return x + static_cast<int>(i.get_linear_id()); });
+
+            THEN("every element is one more than its linear index")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == static_cast<int>(i) + 1);
+                }
+            }
+        }
+
+        WHEN("launching with a work group size which does not divide the range")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform(distr<class mul3_wg, 5, 5>(q), buf, buf_out, [](int x) { return 3 * x; });
+
+            THEN("the task falls back to the default size and every element is 3")
+            {
+                const auto r = copy_to_host(q, buf_out);
+                REQUIRE(elements_equal_to<3>(r));
+            }
+        }
+    }
+
     GIVEN("Two two-dimensional buffers of 10x10 1s and a 10x10 4s")
     {
         constexpr auto rank = 10;
@@ -327,6 +835,721 @@ SCENARIO("transforming a buffer", "[celerity::algorithm]")
     }
 }
 
+SCENARIO("transforming a buffer with time blocking", "[celerity::algorithm]")
+{
+    using celerity::algorithm::chunk;
+
+    distr_queue q;
+
+    constexpr auto size = 100;
+
+    auto gen_i = [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id() % 7); };
+
+    GIVEN("A one-dimensional buffer and a stencil summing up the neighbours of an element")
+    {
+        buffer<int, 1> buf(cl::sycl::range<1>{size});
+
+        generate<class gen_blocked_sum>(q, buf, gen_i);
+
+        const auto sum_3 = [](const chunk<int, 3> &c) { return c.discern(0, [&]() { return c[{-1}] + *c + c[{1}]; }); };
+
+        WHEN("applying the stencil three times in one kernel")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            transform<class sum_3_blocked>(q, buf, buf_out, time_blocked<3>(sum_3));
+
+            THEN("the result equals three separate applications")
+            {
+                std::vector<int> expected(size);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    expected[i] = i % 7;
+                }
+
+                for (auto step = 0; step < 3; ++step)
+                {
+                    auto next = expected;
+
+                    for (auto i = 0; i < size; ++i)
+                    {
+                        next[i] = (i == 0 || i == size - 1) ? 0 : expected[i - 1] + expected[i] + expected[i + 1];
+                    }
+
+                    expected = next;
+                }
+
+                const auto r = copy_to_host(q, buf_out);
+                REQUIRE(std::equal(begin(expected), end(expected), begin(r)));
+            }
+        }
+    }
+
+    GIVEN("Two one-dimensional buffers holding two subsequent steps of a recurrence")
+    {
+        buffer<int, 1> buf_prev(cl::sycl::range<1>{size});
+        buffer<int, 1> buf_curr(cl::sycl::range<1>{size});
+
+        fill<class fill_blocked_prev>(q, buf_prev, 1);
+        generate<class gen_blocked_curr>(q, buf_curr, gen_i);
+
+        const auto leap = [](int prev, const chunk<int, 3> &c) { return c.discern(0, [&]() { return c[{-1}] + c[{1}] - prev; }); };
+
+        WHEN("advancing the recurrence by four steps in a pipeline")
+        {
+            auto buf_out = buf_prev | transform<class leap_blocked>(time_blocked<4>(leap)) << buf_curr | submit_to(q);
+
+            THEN("the result equals four separate steps")
+            {
+                std::vector<int> prev(size, 1);
+                std::vector<int> curr(size);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    curr[i] = i % 7;
+                }
+
+                for (auto step = 0; step < 4; ++step)
+                {
+                    std::vector<int> next(size);
+
+                    for (auto i = 0; i < size; ++i)
+                    {
+                        next[i] = (i == 0 || i == size - 1) ? 0 : curr[i - 1] + curr[i + 1] - prev[i];
+                    }
+
+                    prev = curr;
+                    curr = next;
+                }
+
+                const auto r = copy_to_host(q, buf_out);
+                REQUIRE(std::equal(begin(curr), end(curr), begin(r)));
+            }
+        }
+
+        WHEN("advancing the recurrence twice by two steps, each time computing both of the last two steps")
+        {
+            const auto [to_prev, to_curr] = time_blocked_pair<2>(leap);
+
+            auto buf_prev_2 = buf_prev | transform<class leap_pair_prev_1>(to_prev) << buf_curr | submit_to(q);
+            auto buf_curr_2 = buf_prev | transform<class leap_pair_curr_1>(to_curr) << buf_curr | submit_to(q);
+
+            auto buf_out = buf_prev_2 | transform<class leap_pair_curr_2>(to_curr) << buf_curr_2 | submit_to(q);
+
+            THEN("the result equals four separate steps")
+            {
+                std::vector<int> prev(size, 1);
+                std::vector<int> curr(size);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    curr[i] = i % 7;
+                }
+
+                for (auto step = 0; step < 4; ++step)
+                {
+                    std::vector<int> next(size);
+
+                    for (auto i = 0; i < size; ++i)
+                    {
+                        next[i] = (i == 0 || i == size - 1) ? 0 : curr[i - 1] + curr[i + 1] - prev[i];
+                    }
+
+                    prev = curr;
+                    curr = next;
+                }
+
+                const auto r = copy_to_host(q, buf_out);
+                REQUIRE(std::equal(begin(curr), end(curr), begin(r)));
+            }
+        }
+    }
+}
+
+SCENARIO("accumulating a buffer", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of numbers 1 to 100")
+    {
+        constexpr auto size = 100;
+
+        buffer<int, 1> buf(cl::sycl::range<1>{size});
+
+        generate<class iota_acc>(q, buf, [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id()) + 1; });
+
+        WHEN("summing up all elements")
+        {
+            const auto sum = accumulate<class sum_1d>(q, buf, 0, std::plus<int>{});
+
+            THEN("the result is the sum of numbers 1 to 100")
+            {
+                REQUIRE(sum == sum_one_to_n<size>);
+            }
+        }
+
+        WHEN("summing up all elements twice without waiting for the first result")
+        {
+            auto first = accumulate_async(distr<class sum_1d_async>(q), buf, 0, std::plus<int>{});
+            auto second = accumulate_async(distr<class sum_1d_async_init>(q), buf, 5, std::plus<int>{});
+
+            THEN("the futures receive the results in order")
+            {
+                REQUIRE(first.get() == sum_one_to_n<size>);
+                REQUIRE(second.get() == sum_one_to_n<size> + 5);
+            }
+        }
+
+        WHEN("summing up all elements three times, getting the results in reverse order and dropping one")
+        {
+            auto first = accumulate_async(distr<class sum_1d_async_first>(q), buf, 0, std::plus<int>{});
+            accumulate_async(distr<class sum_1d_async_dropped>(q), buf, 1, std::plus<int>{});
+            auto third = accumulate_async(distr<class sum_1d_async_third>(q), buf, 2, std::plus<int>{});
+
+            THEN("the futures receive their results without the nodes waiting for each other")
+            {
+                REQUIRE(third.get() == sum_one_to_n<size> + 2);
+                REQUIRE(first.get() == sum_one_to_n<size>);
+            }
+        }
+
+        WHEN("summing up all elements with an initial value")
+        {
+            const auto sum = accumulate<class sum_1d_init>(q, buf, 5, std::plus<int>{});
+
+            THEN("the initial value is added exactly once")
+            {
+                REQUIRE(sum == sum_one_to_n<size> + 5);
+            }
+        }
+
+        WHEN("summing up a subrange")
+        {
+            auto beg = begin(buf);
+            beg += cl::sycl::id<1>{50};
+
+            const auto sum = accumulate<class sum_1d_sub>(q, beg, end(buf), 0, std::plus<int>{});
+
+            THEN("only the elements in the subrange are summed up")
+            {
+                REQUIRE(sum == sum_one_to_n<size> - sum_one_to_n<50>);
+            }
+        }
+
+        WHEN("summing up all elements in work groups of 10")
+        {
+            const auto sum = accumulate(distr<class sum_1d_wg, 10>(q), buf, 0, std::plus<int>{});
+
+            THEN("the result is the sum of numbers 1 to 100")
+            {
+                REQUIRE(sum == sum_one_to_n<size>);
+            }
+        }
+    }
+
+    GIVEN("A one-dimensional buffer spanning many work groups of the reduction")
+    {
+        constexpr auto size = 10000;
+
+        buffer<int, 1> buf(cl::sycl::range<1>{size});
+
+        generate<class iota_acc_large>(q, buf, [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id()) + 1; });
+
+        WHEN("searching for the maximum")
+        {
+            const auto max = accumulate<class max_1d>(q, buf, 0, [](int a, int b) { return std::max(a, b); });
+
+            THEN("the result is the last element")
+            {
+                REQUIRE(max == size);
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 4 long rows of increasing numbers")
+    {
+        constexpr auto rows = 4;
+        constexpr auto cols = 1000;
+
+        buffer<int, 2> buf({rows, cols});
+
+        generate<class iota_acc_rows>(q, buf, [](cl::sycl::item<2> i) { return static_cast<int>(i.get_linear_id()) + 1; });
+
+        WHEN("folding with an associative operation which keeps its right operand")
+        {
+            const auto last = accumulate<class last_2d>(q, buf, 0, [](int, int b) { return b; });
+
+            THEN("the partial results are combined in row-major order and the result is the last element")
+            {
+                REQUIRE(last == rows * cols);
+            }
+        }
+    }
+
+    GIVEN("A three-dimensional buffer of 10x10x10 1s")
+    {
+        constexpr auto rank = 10;
+
+        buffer<int, 3> buf({rank, rank, rank});
+
+        fill<class fill_acc_10x10x10>(q, buf, 1);
+
+        WHEN("summing up all elements")
+        {
+            const auto sum = accumulate<class sum_3d>(q, buf, 0, std::plus<int>{});
+
+            THEN("the result is the number of elements")
+            {
+                REQUIRE(sum == rank * rank * rank);
+            }
+        }
+    }
+}
+
+SCENARIO("scanning a buffer", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of 3000 1s, more than one element per block")
+    {
+        constexpr auto size = 3000;
+
+        buffer<int, 1> buf(cl::sycl::range<1>{size});
+
+        fill<class fill_scan_1d>(q, buf, 1);
+
+        WHEN("computing the inclusive prefix sums")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            inclusive_scan<class inclusive_sum_1d>(q, buf, buf_out, std::plus<int>{});
+
+            THEN("every element is its index plus 1")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == static_cast<int>(i) + 1);
+                }
+            }
+        }
+
+        WHEN("computing the exclusive prefix sums starting from 5")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            exclusive_scan<class exclusive_sum_1d>(q, buf, buf_out, 5, std::plus<int>{});
+
+            THEN("every element is its index plus 5")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == static_cast<int>(i) + 5);
+                }
+            }
+        }
+
+        WHEN("computing the inclusive prefix sums of a subrange into the same positions")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+            fill<class fill_scan_out_1d>(q, buf_out, 0);
+
+            auto beg = begin(buf);
+            beg += cl::sycl::id<1>{1000};
+
+            auto out = begin(buf_out);
+            out += cl::sycl::id<1>{1000};
+
+            inclusive_scan(distr<class inclusive_sum_1d_sub>(q), beg, end(buf), out, std::plus<int>{}, 10);
+
+            THEN("the scan starts at the subrange and leaves the elements before it untouched")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == (i < 1000 ? 0 : static_cast<int>(i) - 1000 + 11));
+                }
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 6x4 increasing numbers")
+    {
+        const auto src = ascending_elements(6 * 4);
+
+        buffer<int, 2> buf(src.data(), {6, 4});
+
+        WHEN("computing the running maximum of the negated elements")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform<class negate_scan_2d>(q, buf, buf_out, [](int x) { return -x; });
+            inclusive_scan<class max_2d>(q, buf_out, buf_out, [](int a, int b) { return std::max(a, b); });
+
+            THEN("the elements are scanned in row-major order")
+            {
+                const auto r = copy_to_host(q, buf_out);
+                REQUIRE(std::all_of(begin(r), end(r), [](int x) { return x == 0; }));
+            }
+        }
+
+        WHEN("computing the inclusive prefix sums in row-major order")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            inclusive_scan<class inclusive_sum_2d>(q, buf, buf_out, std::plus<int>{});
+
+            THEN("every element is the sum of all elements up to it")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == static_cast<int>(i * (i + 1) / 2));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("compacting a buffer", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of the numbers 0 to 2999")
+    {
+        constexpr auto size = 3000;
+
+        const auto src = ascending_elements(size);
+
+        buffer<int, 1> buf(src.data(), {size});
+
+        WHEN("copying the multiples of 7")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            const auto n = copy_if<class copy_multiples_of_7>(q, buf, buf_out, [](int x) { return x % 7 == 0; });
+
+            THEN("the multiples are packed densely in order")
+            {
+                REQUIRE(n == (size + 6) / 7);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    REQUIRE(r[i] == 7 * static_cast<int>(i));
+                }
+            }
+        }
+
+        WHEN("removing the elements smaller than 2990 from the elements from 1000 on")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            auto beg = begin(buf);
+            beg += cl::sycl::id<1>{1000};
+
+            auto out = begin(buf_out);
+            out += cl::sycl::id<1>{5};
+
+            const auto n = remove_if(distr<class remove_small>(q), beg, end(buf), out, [](int x) { return x < 2990; });
+
+            THEN("the remaining elements are written from the output position on")
+            {
+                REQUIRE(n == 10);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    REQUIRE(r[5 + i] == 2990 + static_cast<int>(i));
+                }
+            }
+        }
+
+        WHEN("copying no element")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            const auto n = copy_if<class copy_none>(q, buf, buf_out, [](int x) { return x < 0; });
+
+            THEN("the number of copied elements is 0")
+            {
+                REQUIRE(n == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("sorting a buffer", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of 3000 pseudo-random numbers with duplicates")
+    {
+        constexpr auto size = 3000;
+
+        const auto src = indexed_elements(size, [](size_t i) { return static_cast<int>((i * 7919) % 1009); });
+
+        buffer<int, 1> buf(src.data(), {size});
+
+        WHEN("sorting the buffer")
+        {
+            sort<class sort_ascending>(q, buf);
+
+            THEN("the buffer holds the same elements in ascending order")
+            {
+                auto expected = src;
+                std::sort(begin(expected), end(expected));
+
+                REQUIRE(copy_to_host(q, buf) == expected);
+            }
+        }
+
+        WHEN("sorting the elements from 1000 to 2499 in descending order")
+        {
+            auto beg = begin(buf);
+            beg += cl::sycl::id<1>{1000};
+
+            auto last = begin(buf);
+            last += cl::sycl::id<1>{2500};
+
+            sort(distr<class sort_descending>(q), beg, last, std::greater<int>{});
+
+            THEN("only the elements of the range are sorted")
+            {
+                auto expected = src;
+                std::sort(begin(expected) + 1000, begin(expected) + 2500, std::greater<int>{});
+
+                REQUIRE(copy_to_host(q, buf) == expected);
+            }
+        }
+
+        WHEN("sorting the indices of the elements by the elements")
+        {
+            const auto indices = ascending_elements(size);
+
+            buffer<int, 1> values(indices.data(), {size});
+
+            sort_by_key<class sort_indices>(q, buf, values);
+
+            THEN("every index moves along with its element")
+            {
+                const auto keys = copy_to_host(q, buf);
+                const auto r = copy_to_host(q, values);
+
+                REQUIRE(std::is_sorted(begin(keys), end(keys)));
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    REQUIRE(src[r[i]] == keys[i]);
+                }
+            }
+        }
+    }
+
+    GIVEN("A one-dimensional buffer of 5000 equal numbers")
+    {
+        constexpr auto size = 5000;
+
+        std::vector<int> src(size, 7);
+        buffer<int, 1> buf(src.data(), {size});
+
+        WHEN("sorting the indices of the elements by the elements")
+        {
+            const auto indices = ascending_elements(size);
+
+            buffer<int, 1> values(indices.data(), {size});
+
+            sort_by_key<class sort_equal_keys>(q, buf, values);
+
+            THEN("the keys are unchanged and the indices keep their order")
+            {
+                REQUIRE(copy_to_host(q, buf) == src);
+                REQUIRE(copy_to_host(q, values) == indices);
+            }
+        }
+    }
+
+    GIVEN("A one-dimensional buffer of a single element")
+    {
+        std::vector<int> src{42};
+        buffer<int, 1> buf(src.data(), {1});
+
+        WHEN("sorting the buffer")
+        {
+            sort<class sort_single>(q, buf);
+
+            THEN("the element is left untouched")
+            {
+                REQUIRE(copy_to_host(q, buf) == src);
+            }
+        }
+    }
+}
+
+SCENARIO("counting the elements of a buffer in bins", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of the numbers 0 to 2999")
+    {
+        constexpr auto size = 3000;
+
+        const auto src = ascending_elements(size);
+
+        buffer<int, 1> buf(src.data(), {size});
+
+        WHEN("counting the numbers by their hundreds")
+        {
+            buffer<size_t, 1> bins(cl::sycl::range<1>{30});
+
+            histogram<class count_hundreds>(q, buf, bins, [](int x) { return static_cast<size_t>(x / 100); });
+
+            THEN("every bin holds a hundred numbers")
+            {
+                REQUIRE(copy_to_host(q, bins) == std::vector<size_t>(30, 100));
+            }
+        }
+
+        WHEN("counting the numbers from 1000 on by their remainder of 7 in fewer bins than remainders")
+        {
+            buffer<int, 1> bins(cl::sycl::range<1>{5});
+
+            auto beg = begin(buf);
+            beg += cl::sycl::id<1>{1000};
+
+            histogram(distr<class count_remainders>(q), beg, end(buf), bins, [](int x) { return static_cast<size_t>(x % 7); });
+
+            THEN("the numbers of the missing bins are skipped")
+            {
+                std::vector<int> expected(5);
+
+                for (int x = 1000; x < size; ++x)
+                {
+                    if (x % 7 < 5)
+                    {
+                        ++expected[x % 7];
+                    }
+                }
+
+                REQUIRE(copy_to_host(q, bins) == expected);
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 50 x 40 1s")
+    {
+        std::vector<int> src(50 * 40, 1);
+        buffer<int, 2> buf(src.data(), {50, 40});
+
+        WHEN("counting the elements in a single bin")
+        {
+            buffer<size_t, 1> bins(cl::sycl::range<1>{1});
+
+            histogram<class count_all>(q, buf, bins, [](int x) { return static_cast<size_t>(x - 1); });
+
+            THEN("the bin holds all elements")
+            {
+                REQUIRE(copy_to_host(q, bins)[0] == 50 * 40);
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 3 x 5000 elements holding their column")
+    {
+        const auto src = indexed_elements(3 * 5000, [](size_t i) { return static_cast<int>(i % 5000); });
+
+        buffer<int, 2> buf(src.data(), {3, 5000});
+
+        WHEN("counting the elements by their column in more bins than a work group counts at once")
+        {
+            buffer<size_t, 1> bins(cl::sycl::range<1>{5000});
+
+            histogram<class count_columns>(q, buf, bins, [](int x) { return static_cast<size_t>(x); });
+
+            THEN("every bin holds the elements of one column")
+            {
+                REQUIRE(copy_to_host(q, bins) == std::vector<size_t>(5000, 3));
+            }
+        }
+    }
+}
+
+SCENARIO("reducing a buffer along a dimension", "[celerity::algorithm]")
+{
+    distr_queue q;
+
+    GIVEN("A two-dimensional buffer of 50 x 40 elements holding their column")
+    {
+        constexpr auto rows = 50;
+        constexpr auto cols = 40;
+
+        const auto src = indexed_elements(rows * cols, [](size_t i) { return static_cast<int>(i % cols); });
+
+        buffer<int, 2> buf(src.data(), {rows, cols});
+
+        WHEN("summing the rows")
+        {
+            buffer<int, 1> buf_out(cl::sycl::range<1>{rows});
+
+            reduce_dim<class sum_rows, 1>(q, buf, buf_out, [](int a, int b) { return a + b; });
+
+            THEN("every row sums up to the sum of the columns")
+            {
+                REQUIRE(copy_to_host(q, buf_out) == std::vector<int>(rows, sum_one_to_n<cols - 1>));
+            }
+        }
+
+        WHEN("summing the columns")
+        {
+            buffer<int, 1> buf_out(cl::sycl::range<1>{cols});
+
+            reduce_dim<0>(distr<class sum_columns>(q), buf, buf_out, [](int a, int b) { return a + b; });
+
+            THEN("every column sums up to its index times the number of rows")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < cols; ++i)
+                {
+                    REQUIRE(r[i] == rows * static_cast<int>(i));
+                }
+            }
+        }
+    }
+
+    GIVEN("A three-dimensional buffer of 10 x 20 x 30 elements holding their first index")
+    {
+        const auto src = indexed_elements(10 * 20 * 30, [](size_t i) { return static_cast<int>(i / (20 * 30)); });
+
+        buffer<int, 3> buf(src.data(), {10, 20, 30});
+
+        WHEN("taking the maximum along the second dimension")
+        {
+            buffer<int, 2> buf_out(cl::sycl::range<2>{10, 30});
+
+            reduce_dim<class max_columns, 1>(q, buf, buf_out, [](int a, int b) { return std::max(a, b); });
+
+            THEN("every element of the output holds its first index")
+            {
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == static_cast<int>(i / 30));
+                }
+            }
+        }
+    }
+}
+
 // SCENARIO("iterating a buffer on the master", "[celerity::algorithm]")
 // {
 //     distr_queue q;
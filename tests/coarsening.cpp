@@ -0,0 +1,152 @@
+#define CATCH_CONFIG_MAIN
+
+#pragma clang diagnostic warning "-Wall"
+
+#include "utils.h"
+
+#include <numeric>
+
+using namespace celerity;
+using namespace celerity::algorithm;
+
+SCENARIO("Processing several elements per work item", "[algorithm::coarsening]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of a hundred elements")
+    {
+        constexpr auto size = 100;
+
+        buffer<int, 1> buf(cl::sycl::range<1>{size});
+
+        WHEN("generating it in runs of 8 elements per work item, leaving a tail of 4")
+        {
+            generate(distr_coarse<class iota_coarse_8, 8>(q), begin(buf), end(buf), [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id()); });
+
+            THEN("every element is generated exactly once from its own item")
+            {
+                const auto r = copy_to_host(q, buf);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    REQUIRE(r[i] == i);
+                }
+            }
+        }
+
+        WHEN("filling it and tripling it in runs of 16 elements per work item")
+        {
+            fill(distr_coarse<class fill_coarse_16, 16>(q), buf, 1);
+
+            buffer<int, 1> buf_out(buf.get_range());
+            transform(distr_coarse<class mul3_coarse_16, 16>(q), buf, buf_out, [](int x) { return 3 * x; });
+
+            THEN("every element is 3 in the target buffer")
+            {
+                const auto r = copy_to_host(q, buf_out);
+                REQUIRE(elements_equal_to<3>(r));
+            }
+        }
+
+        WHEN("transforming a subrange in runs of 8 elements per work item")
+        {
+            fill<class fill_coarse_sub>(q, buf, 1);
+
+            auto beg = begin(buf);
+            beg += cl::sycl::id<1>{37};
+
+            transform(distr_coarse<class add_coarse_sub, 8>(q), beg, end(buf), beg, [](int x) { return x + 1; });
+
+            THEN("only the elements of the subrange are transformed")
+            {
+                const auto r = copy_to_host(q, buf);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    REQUIRE(r[i] == (i < 37 ? 1 : 2));
+                }
+            }
+        }
+
+        WHEN("summing up all elements in runs of 4 per work item")
+        {
+            generate<class iota_coarse_acc>(q, buf, [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id()) + 1; });
+
+            const auto sum = accumulate(distr_coarse<class sum_coarse_4, 4>(q), buf, 0, std::plus<int>{});
+
+            THEN("the result is the sum of numbers 1 to 100")
+            {
+                REQUIRE(sum == size * (size + 1) / 2);
+            }
+        }
+    }
+
+    GIVEN("Two two-dimensional buffers of 6x10 elements")
+    {
+        buffer<int, 2> buf_a({6, 10});
+        buffer<int, 2> buf_b({6, 10});
+
+        generate<class gen_coarse_a>(q, buf_a, [](cl::sycl::item<2> i) { return static_cast<int>(i.get_linear_id()); });
+        fill<class fill_coarse_b>(q, buf_b, 2);
+
+        WHEN("multiplying them in runs of 4 elements per work item of a row")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform(distr_coarse<class mul_coarse_2d, 4>(q), buf_a, buf_b, buf_c, std::multiplies<int>{});
+
+            THEN("every row is processed completely including its tail")
+            {
+                const auto r = copy_to_host(q, buf_c);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == 2 * static_cast<int>(i));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Mapping chunks of coarsened work items to elements", "[algorithm::coarsening]")
+{
+    using namespace celerity::algorithm::detail;
+
+    GIVEN("A one-to-one range mapper")
+    {
+        const celerity::chunk<2> first{{0, 0}, {2, 2}, {6, 3}};
+        const celerity::chunk<2> last{{4, 2}, {2, 1}, {6, 3}};
+
+        WHEN("no coarsened task is built")
+        {
+            const auto mapper = map_to_elements<2>(celerity::access::one_to_one<2>{});
+
+            THEN("chunks are mapped to themselves")
+            {
+                const auto sr = mapper(last);
+
+                REQUIRE(sr.offset == cl::sycl::id<2>{4, 2});
+                REQUIRE(sr.range == cl::sycl::range<2>{2, 1});
+            }
+        }
+
+        WHEN("the command group of a task processing 4 elements per work item of 6x10 elements is built")
+        {
+            const coarsened_launch_scope<2> scope{4, cl::sycl::id<2>{0, 0}, cl::sycl::range<2>{6, 10}};
+            const auto mapper = map_to_elements<2>(celerity::access::one_to_one<2>{});
+
+            THEN("chunks are widened along the last dimension and clamped to the range of the task")
+            {
+                const auto sr = mapper(first);
+
+                REQUIRE(sr.offset == cl::sycl::id<2>{0, 0});
+                REQUIRE(sr.range == cl::sycl::range<2>{2, 8});
+
+                const auto sr_last = mapper(last);
+
+                REQUIRE(sr_last.offset == cl::sycl::id<2>{4, 8});
+                REQUIRE(sr_last.range == cl::sycl::range<2>{2, 2});
+            }
+        }
+    }
+}
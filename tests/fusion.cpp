@@ -1042,4 +1042,403 @@ SCENARIO("Fusing two tasks", "[fusion::simple]")
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Fusing a reduction", "[fusion::reduce]")
+{
+    celerity::distr_queue q{};
+
+    GIVEN("A transform kernel and a buffer of hundred 2s")
+    {
+        auto square = [](int x) { return x * x; };
+
+        constexpr auto size = 100;
+        std::vector<int> src(size, 2);
+        celerity::buffer<int, 1> buf_in(src.data(), {size});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class square_38>(square);
+            auto t2 = accumulate<class sum_39>(0, std::plus<int>{});
+
+            auto seq = buf_in | t1 | t2;
+            const auto result = seq | submit_to(q);
+
+            THEN("kernels are fused and the result is 400")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                REQUIRE(result == 400);
+            }
+        }
+    }
+
+    GIVEN("Two transform kernels and a buffer of hundred 2s")
+    {
+        auto square = [](int x) { return x * x; };
+        auto add_1 = [](int x) { return x + 1; };
+
+        constexpr auto size = 100;
+        std::vector<int> src(size, 2);
+        celerity::buffer<int, 1> buf_in(src.data(), {size});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class square_60>(square);
+            auto t2 = transform<class add_61>(add_1);
+            auto t3 = accumulate<class sum_62>(0, std::plus<int>{});
+
+            auto seq = buf_in | t1 | t2 | t3;
+            const auto result = seq | submit_to(q);
+
+            THEN("kernels are fused and the result is 500")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 3);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                REQUIRE(result == 500);
+            }
+        }
+    }
+
+    GIVEN("A generate kernel")
+    {
+        constexpr auto size = 100;
+
+        auto gen_i = [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id()); };
+
+        WHEN("chaining calls")
+        {
+            auto t1 = generate_n<class gen_item_id_40>(cl::sycl::range<1>{size}, gen_i);
+            auto t2 = accumulate<class sum_41>(1, std::plus<int>{});
+
+            auto seq = t1 | t2;
+            const auto result = seq | submit_to(q);
+
+            THEN("kernels are fused and the result is the sum of all ids plus 1")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                REQUIRE(result == size * (size - 1) / 2 + 1);
+            }
+        }
+    }
+
+    GIVEN("A transform kernel, a prefix sum and a buffer of 2000 2s")
+    {
+        auto square = [](int x) { return x * x; };
+
+        constexpr auto size = 2000;
+        std::vector<int> src(size, 2);
+        celerity::buffer<int, 1> buf_in(src.data(), {size});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class square_scan_45>(square);
+            auto t2 = exclusive_scan<class scan_46>(1, std::plus<int>{});
+
+            auto seq = buf_in | t1 | t2;
+            auto buf_out = seq | submit_to(q);
+
+            THEN("kernels are fused and every element is 1 plus 4 times its index")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < r.size(); ++i)
+                {
+                    REQUIRE(r[i] == 1 + 4 * static_cast<int>(i));
+                }
+            }
+        }
+    }
+
+    GIVEN("A transform kernel, a filter and a buffer of the numbers 0 to 1999")
+    {
+        auto square = [](int x) { return x * x; };
+
+        constexpr auto size = 2000;
+        const auto src = ascending_elements(size);
+        celerity::buffer<int, 1> buf_in(src.data(), {size});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class square_filter_47>(square);
+            auto t2 = copy_if<class even_48>([](int x) { return x % 2 == 0; });
+
+            auto seq = buf_in | t1 | t2;
+            auto [buf_out, n] = seq | submit_to(q);
+
+            THEN("kernels are fused and the output holds exactly the even squares")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                REQUIRE(n == size / 2);
+                REQUIRE(buf_out.get_range()[0] == n);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    REQUIRE(r[i] == 4 * static_cast<int>(i * i));
+                }
+            }
+        }
+    }
+
+    GIVEN("A transform kernel, a histogram and a buffer of the numbers 0 to 1999")
+    {
+        auto halve = [](int x) { return x / 2; };
+
+        constexpr auto size = 2000;
+        const auto src = ascending_elements(size);
+        celerity::buffer<int, 1> buf_in(src.data(), {size});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class halve_49>(halve);
+            auto t2 = histogram<class last_digit_50>(10, [](int x) { return static_cast<size_t>(x % 10); });
+
+            auto seq = buf_in | t1 | t2;
+            auto buf_out = seq | submit_to(q);
+
+            THEN("kernels are fused and every bin counts a tenth of the halved numbers")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                REQUIRE(r == std::vector<size_t>(10, size / 10));
+            }
+        }
+    }
+
+    GIVEN("A transform kernel, a reduction along the rows and a 2D buffer of 1s")
+    {
+        auto add_1 = [](int x) { return x + 1; };
+
+        constexpr auto rows = 30;
+        constexpr auto cols = 20;
+        std::vector<int> src(rows * cols, 1);
+        celerity::buffer<int, 2> buf_in(src.data(), {rows, cols});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class add_51>(add_1);
+            auto t2 = reduce_dim<class sum_rows_52, 1>([](int a, int b) { return a + b; });
+
+            auto seq = buf_in | t1 | t2;
+            auto buf_out = seq | submit_to(q);
+
+            THEN("kernels are fused and every row sums up to twice the number of columns")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                REQUIRE(buf_out.get_range()[0] == rows);
+                REQUIRE(copy_to_host(q, buf_out) == std::vector<int>(rows, 2 * cols));
+            }
+        }
+    }
+
+    GIVEN("A slice transform kernel and a 2D buffer")
+    {
+        constexpr auto size = 10;
+
+        auto row_sum = [](const slice<int, 1> &s) {
+            int sum = 0;
+            for (int i = 0; i < s.get_range(); ++i)
+            {
+                sum += s[i];
+            }
+            return sum;
+        };
+
+        buffer<int, 2> buf_in{{size, size}};
+        fill<class fill_42>(q, begin(buf_in), end(buf_in), 1);
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class row_sum_43>(row_sum);
+            auto t2 = accumulate<class sum_44>(0, std::plus<int>{});
+
+            auto seq = buf_in | t1 | t2;
+            const auto result = seq | submit_to(q);
+
+            THEN("kernels are fused and the result is 1000")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                REQUIRE(result == size * size * size);
+            }
+        }
+    }
+}
+
+SCENARIO("Fusing trees of tasks", "[fusion::tree]")
+{
+    celerity::distr_queue q{};
+
+    constexpr auto size = 100;
+
+    using celerity::algorithm::chunk;
+
+    auto mul_2 = [](int x) { return x * 2; };
+    auto add = [](int x, int y) { return x + y; };
+    auto add_chunk = [](int x, const chunk<int, 1> &y) { return x + *y; };
+
+    buffer<int, 1> buf_a{{size}};
+    buffer<int, 1> buf_b{{size}};
+    buffer<int, 1> buf_c{{size}};
+    fill<class _40>(q, begin(buf_a), end(buf_a), 1);
+    fill<class _41>(q, begin(buf_b), end(buf_b), 2);
+    fill<class _42>(q, begin(buf_c), end(buf_c), 3);
+
+    GIVEN("A zip kernel whose second input is computed by another zip kernel")
+    {
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class mul_2_43>(mul_2);
+            auto t2 = transform<class add_44>(add);
+            auto t3 = transform<class add_45>(add);
+            auto t4 = transform<class mul_2_46>(mul_2);
+
+            auto seq = buf_a | t3 << (buf_b | t2 << (buf_c | t1)) | t4;
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("all kernels are fused and the result is 18")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                static_assert(!is_t_joint_v<last_element_t<fused_t<seq_type>>>);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    REQUIRE(r[i] == 18);
+                }
+            }
+        }
+    }
+
+    GIVEN("A zip kernel whose second input is a zip kernel followed by a transform kernel")
+    {
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class mul_2_47>(mul_2);
+            auto t2 = transform<class add_48>(add);
+            auto t3 = transform<class add_49>(add);
+            auto t4 = transform<class mul_2_50>(mul_2);
+
+            auto seq = buf_a | t3 << (buf_b | t2 << (buf_c | t1) | t4);
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("all kernels are fused and the result is 17")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                static_assert(!is_t_joint_v<last_element_t<fused_t<seq_type>>>);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    REQUIRE(r[i] == 17);
+                }
+            }
+        }
+    }
+
+    GIVEN("A tree of four inputs containing a zip kernel which reads a chunk of its second input")
+    {
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class mul_2_51>(mul_2);
+            auto t2 = transform<class mul_2_52>(mul_2);
+            auto t3 = transform<class mul_2_53>(mul_2);
+            auto t4 = transform<class add_chunk_54>(add_chunk);
+            auto t5 = transform<class add_55>(add);
+            auto t6 = transform<class add_56>(add);
+
+            auto seq = buf_a | t1 | t6 << (buf_b | t2 | t5 << (buf_c | t4 << (buf_a | t3)));
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("all kernels up to the chunk access are fused and the result is 11")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                static_assert(is_t_joint_v<last_element_t<fused_t<seq_type>>>);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    REQUIRE(r[i] == 11);
+                }
+            }
+        }
+    }
+
+    GIVEN("A zip kernel which reads a chunk of a fusable secondary sequence")
+    {
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class mul_2_57>(mul_2);
+            auto t2 = transform<class mul_2_58>(mul_2);
+            auto t3 = transform<class add_chunk_59>(add_chunk);
+
+            auto seq = buf_a | t3 << (buf_b | t1 | t2);
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("the secondary sequence is fused and the result is 9")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<fused_t<seq_type>> == 1);
+                static_assert(size_v<secondary_sequence_t<last_element_t<fused_t<seq_type>>>> == 1);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (auto i = 0; i < size; ++i)
+                {
+                    REQUIRE(r[i] == 9);
+                }
+            }
+        }
+    }
+}
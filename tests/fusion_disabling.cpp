@@ -1015,4 +1015,36 @@ SCENARIO("Fusing two tasks", "[fusion::simple]")
             }
         }
     }
-}
\ No newline at end of file
+}
+
+SCENARIO("Fusing a reduction", "[fusion::reduce]")
+{
+    celerity::distr_queue q{};
+
+    GIVEN("A transform kernel and a buffer of hundred 2s")
+    {
+        auto square = [](int x) { return x * x; };
+
+        constexpr auto size = 100;
+        std::vector<int> src(size, 2);
+        celerity::buffer<int, 1> buf_in(src.data(), {size});
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class square_38>(square);
+            auto t2 = accumulate<class sum_39>(0, std::plus<int>{});
+
+            auto seq = buf_in | t1 | t2;
+            const auto result = seq | submit_to(q);
+
+            THEN("kernels are not fused and the result is 400")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == size_v<fused_t<seq_type>>);
+
+                REQUIRE(result == 400);
+            }
+        }
+    }
+}
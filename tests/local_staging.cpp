@@ -0,0 +1,448 @@
+#define CATCH_CONFIG_MAIN
+
+#pragma clang diagnostic warning "-Wall"
+
+#include <algorithm>
+#include <numeric>
+
+#include "utils.h"
+#include "../include/actions.h"
+#include "../include/buffer_traits.h"
+
+using namespace celerity;
+using namespace celerity::algorithm;
+
+SCENARIO("Staging slices through local memory", "[accessors::staging]")
+{
+    distr_queue q;
+
+    using t = traits::buffer_traits<int, 2>;
+
+    const auto multiply = [](const t::device_slice<1> &a, const t::device_slice<0> &b) {
+        return std::inner_product(begin(a), end(a), begin(b), 0);
+    };
+
+    const auto gen_a = [](cl::sycl::item<2> i) { return static_cast<int>((i[0] + 2 * i[1]) % 5); };
+    const auto gen_b = [](cl::sycl::item<2> i) { return static_cast<int>((3 * i[0] + i[1]) % 7); };
+
+    const auto expected_product = [&](size_t rank) {
+        std::vector<int> c(rank * rank);
+
+        for (size_t i = 0; i < rank; ++i)
+        {
+            for (size_t j = 0; j < rank; ++j)
+            {
+                for (size_t k = 0; k < rank; ++k)
+                {
+                    c[i * rank + j] += static_cast<int>((i + 2 * k) % 5) * static_cast<int>((3 * k + j) % 7);
+                }
+            }
+        }
+
+        return c;
+    };
+
+    GIVEN("Two two-dimensional buffers of 32x32")
+    {
+        constexpr auto rank = 32;
+
+        buffer<int, 2> buf_a({rank, rank});
+        buffer<int, 2> buf_b({rank, rank});
+
+        generate<class gen_staged_a>(q, buf_a, gen_a);
+        generate<class gen_staged_b>(q, buf_b, gen_b);
+
+        WHEN("multiplying them by iterating device slices in work groups of 16x16")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform(distr<class staged_mul, 16, 16>(q), buf_a, buf_b, buf_c, multiply);
+
+            THEN("every tile of the slices is staged and the product is computed")
+            {
+                REQUIRE(copy_to_host(q, buf_c) == expected_product(rank));
+            }
+        }
+
+        WHEN("multiplying them in work groups of 8x4")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform(distr<class staged_mul_8x4, 8, 4>(q), buf_a, buf_b, buf_c, multiply);
+
+            THEN("tiles of both widths are staged and the product is computed")
+            {
+                REQUIRE(copy_to_host(q, buf_c) == expected_product(rank));
+            }
+        }
+
+        WHEN("multiplying them in a pipeline")
+        {
+            auto buf_c = buf_a | transform<class staged_mul_seq, 16, 16>(multiply) << buf_b | submit_to(q);
+
+            THEN("the product is computed")
+            {
+                REQUIRE(copy_to_host(q, buf_c) == expected_product(rank));
+            }
+        }
+    }
+
+    GIVEN("Two two-dimensional buffers of 20x20")
+    {
+        constexpr auto rank = 20;
+
+        buffer<int, 2> buf_a({rank, rank});
+        buffer<int, 2> buf_b({rank, rank});
+
+        generate<class gen_staged_a_20>(q, buf_a, gen_a);
+        generate<class gen_staged_b_20>(q, buf_b, gen_b);
+
+        WHEN("multiplying them without requesting a work group size")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            transform<class unstaged_mul_20>(q, buf_a, buf_b, buf_c, multiply);
+
+            THEN("the slices are read from global memory and the product is computed")
+            {
+                REQUIRE(copy_to_host(q, buf_c) == expected_product(rank));
+            }
+        }
+
+        WHEN("summing a different number of elements of the rows in every work item of groups of 4x4")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            // work items stop iterating after column + 1 elements and read the first element again once they are done
+            const auto partial_sums = [](const t::device_slice<1> &a) {
+                const auto n = a.index() + 1;
+
+                auto sum = 0;
+                auto k = 0;
+
+                for (auto it = begin(a); it != end(a) && k < n; ++it, ++k)
+                {
+                    sum += *it;
+                }
+
+                return sum + *begin(a);
+            };
+
+            transform(distr<class staged_partial_sums_4x4, 4, 4>(q), buf_a, buf_c, partial_sums);
+
+            THEN("no work item waits for a tile the others do not load and the sums are computed")
+            {
+                std::vector<int> expected(rank * rank);
+
+                for (size_t i = 0; i < rank; ++i)
+                {
+                    for (size_t j = 0; j < rank; ++j)
+                    {
+                        for (size_t k = 0; k <= j; ++k)
+                        {
+                            expected[i * rank + j] += static_cast<int>((i + 2 * k) % 5);
+                        }
+
+                        expected[i * rank + j] += static_cast<int>(i % 5);
+                    }
+                }
+
+                REQUIRE(copy_to_host(q, buf_c) == expected);
+            }
+        }
+
+        WHEN("returning early in some work items of groups of 4x4 and reading the rows backwards in the others")
+        {
+            buffer<int, 2> buf_c(buf_a.get_range());
+
+            const auto reversed_dot = [](const t::device_slice<1> &a) {
+                if (a.index() % 3 == 0)
+                {
+                    return -1;
+                }
+
+                auto sum = 0;
+
+                for (auto k = a.get_range() - 1; k >= 0; --k)
+                {
+                    sum += (k + 1) * a[k];
+                }
+
+                return sum;
+            };
+
+            transform(distr<class staged_reversed_dot_4x4, 4, 4>(q), buf_a, buf_c, reversed_dot);
+
+            THEN("the slices are staged before the function is invoked and no work item waits for the others")
+            {
+                std::vector<int> expected(rank * rank);
+
+                for (size_t i = 0; i < rank; ++i)
+                {
+                    for (size_t j = 0; j < rank; ++j)
+                    {
+                        if (j % 3 == 0)
+                        {
+                            expected[i * rank + j] = -1;
+                            continue;
+                        }
+
+                        for (size_t k = 0; k < rank; ++k)
+                        {
+                            expected[i * rank + j] += static_cast<int>(k + 1) * static_cast<int>((i + 2 * k) % 5);
+                        }
+                    }
+                }
+
+                REQUIRE(copy_to_host(q, buf_c) == expected);
+            }
+        }
+    }
+
+    GIVEN("A two-dimensional buffer of 8x2048")
+    {
+        constexpr size_t height = 8;
+        constexpr size_t width = 2048;
+
+        buffer<int, 2> buf({height, width});
+
+        generate<class gen_staged_wide>(q, buf, gen_a);
+
+        WHEN("summing the rows in work groups of 4x4")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform(distr<class unstaged_row_sums_4x4, 4, 4>(q), buf, buf_out, [](const t::device_slice<1> &a) {
+                return std::accumulate(begin(a), end(a), 0);
+            });
+
+            THEN("the slices of the group exceed the local memory, are read from global memory and the sums are computed")
+            {
+                std::vector<int> expected(height * width);
+
+                for (size_t i = 0; i < height; ++i)
+                {
+                    auto sum = 0;
+
+                    for (size_t k = 0; k < width; ++k)
+                    {
+                        sum += static_cast<int>((i + 2 * k) % 5);
+                    }
+
+                    std::fill_n(expected.begin() + i * width, width, sum);
+                }
+
+                REQUIRE(copy_to_host(q, buf_out) == expected);
+            }
+        }
+    }
+}
+
+SCENARIO("Staging chunks through local memory", "[accessors::staging]")
+{
+    distr_queue q;
+
+    using t = traits::buffer_traits<int, 2>;
+
+    const auto blur = [](const t::device_chunk<5, 5> &in) {
+        return in.discern(0, [&]() { return std::accumulate(begin(in), end(in), 0); });
+    };
+
+    const auto sharpen = [](const t::device_chunk<3, 3> &in) {
+        return 5 * *in - in[{-1, 0}] - in[{1, 0}] - in[{0, -1}] - in[{0, 1}];
+    };
+
+    const auto gen = [](cl::sycl::item<2> i) { return static_cast<int>((i[0] * 7 + i[1] * 3) % 11); };
+
+    const auto value = [&](long y, long x) { return static_cast<int>((y * 7 + x * 3) % 11); };
+
+    GIVEN("A two-dimensional buffer of 24x20")
+    {
+        constexpr long height = 24;
+        constexpr long width = 20;
+
+        buffer<int, 2> buf({height, width});
+
+        generate<class gen_staged_chunk>(q, buf, gen);
+
+        const auto expected_blur = [&]() {
+            std::vector<int> out(height * width);
+
+            for (long y = 2; y < height - 2; ++y)
+            {
+                for (long x = 2; x < width - 2; ++x)
+                {
+                    for (long dy = -2; dy <= 2; ++dy)
+                    {
+                        for (long dx = -2; dx <= 2; ++dx)
+                        {
+                            out[y * width + x] += value(y + dy, x + dx);
+                        }
+                    }
+                }
+            }
+
+            return out;
+        };
+
+        WHEN("blurring it without requesting a work group size")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform<class unstaged_blur>(q, buf, buf_out, blur);
+
+            THEN("the chunks are read from global memory and the result matches the reference")
+            {
+                REQUIRE(copy_to_host(q, buf_out) == expected_blur());
+            }
+        }
+
+        WHEN("blurring it in work groups of 4x5")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform(distr<class staged_blur_4x5, 4, 5>(q), buf, buf_out, blur);
+
+            THEN("the result matches the reference")
+            {
+                REQUIRE(copy_to_host(q, buf_out) == expected_blur());
+            }
+        }
+
+        WHEN("sharpening it, reading beyond the boundary of the buffer")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            transform(distr<class staged_sharpen_8x4, 8, 4>(q), buf, buf_out, sharpen);
+
+            THEN("elements outside of the buffer are staged as zero")
+            {
+                const auto at = [&](long y, long x) { return y < 0 || y >= height || x < 0 || x >= width ? 0 : value(y, x); };
+
+                std::vector<int> expected(height * width);
+
+                for (long y = 0; y < height; ++y)
+                {
+                    for (long x = 0; x < width; ++x)
+                    {
+                        expected[y * width + x] = 5 * at(y, x) - at(y - 1, x) - at(y + 1, x) - at(y, x - 1) - at(y, x + 1);
+                    }
+                }
+
+                REQUIRE(copy_to_host(q, buf_out) == expected);
+            }
+        }
+
+        WHEN("sharpening only the odd elements, returning early for the even ones")
+        {
+            buffer<int, 2> buf_out(buf.get_range());
+
+            const auto sharpen_odd = [](const t::device_chunk<3, 3> &in) {
+                if (*in % 2 == 0)
+                {
+                    return *in;
+                }
+
+                return in.discern(*in, [&]() { return 5 * *in - in[{-1, 0}] - in[{1, 0}] - in[{0, -1}] - in[{0, 1}]; });
+            };
+
+            transform(distr<class staged_sharpen_odd_4x4, 4, 4>(q), buf, buf_out, sharpen_odd);
+
+            THEN("the chunks are staged before the function is invoked and no work item waits for the others")
+            {
+                std::vector<int> expected(height * width);
+
+                for (long y = 0; y < height; ++y)
+                {
+                    for (long x = 0; x < width; ++x)
+                    {
+                        const auto on_boundary = y == 0 || y == height - 1 || x == 0 || x == width - 1;
+
+                        expected[y * width + x] = value(y, x) % 2 == 0 || on_boundary
+                                                      ? value(y, x)
+                                                      : 5 * value(y, x) - value(y - 1, x) - value(y + 1, x) - value(y, x - 1) - value(y, x + 1);
+                    }
+                }
+
+                REQUIRE(copy_to_host(q, buf_out) == expected);
+            }
+        }
+    }
+}
+
+SCENARIO("Launching kernels in work groups", "[work_groups]")
+{
+    distr_queue q;
+
+    constexpr size_t height = 16;
+    constexpr size_t width = 8;
+
+    const auto local_index = [](const group_item<2> &i) {
+        return i.has_group() ? static_cast<int>(i.get_local_id()[0] * 4 + i.get_local_id()[1]) : -1;
+    };
+
+    const auto expected_local_index = [&]() {
+        std::vector<int> expected(height * width);
+
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                expected[y * width + x] = static_cast<int>((y % 4) * 4 + x % 4);
+            }
+        }
+
+        return expected;
+    };
+
+    GIVEN("A two-dimensional range of 16x8")
+    {
+        const cl::sycl::range<2> range{height, width};
+
+        WHEN("generating the local index of every work item in groups of 4x4")
+        {
+            auto buf = generate_n<class gen_local_index, 4, 4>(range, local_index) | submit_to(q);
+
+            THEN("the generator sees the work group of its item")
+            {
+                REQUIRE(copy_to_host(q, buf) == expected_local_index());
+            }
+        }
+
+        WHEN("fusing the generator with a transform requesting the same groups")
+        {
+            const auto add_group_row = [](const group_item<2> &i, int v) {
+                return v + 100 * static_cast<int>(i.get_group_id()[0]);
+            };
+
+            auto buf = generate_n<class gen_local_index_fused, 4, 4>(range, local_index) |
+                       transform<class add_group_row_fused, 4, 4>(add_group_row) |
+                       submit_to(q);
+
+            THEN("the fused task is launched in the requested groups")
+            {
+                auto expected = expected_local_index();
+
+                for (size_t y = 0; y < height; ++y)
+                {
+                    for (size_t x = 0; x < width; ++x)
+                    {
+                        expected[y * width + x] += 100 * static_cast<int>(y / 4);
+                    }
+                }
+
+                REQUIRE(copy_to_host(q, buf) == expected);
+            }
+        }
+
+        WHEN("requesting groups which do not divide the range")
+        {
+            buffer<int, 2> buf(range);
+
+            THEN("the launch is rejected")
+            {
+                REQUIRE_THROWS_AS(generate(distr<class gen_local_index_3x3, 3, 3>(q), buf, local_index), std::invalid_argument);
+            }
+        }
+    }
+}
@@ -0,0 +1,195 @@
+#define CATCH_CONFIG_MAIN
+
+#pragma clang diagnostic warning "-Wall"
+
+#define CELERITY_STD_ENABLE_OVERLAPPED_TILING
+
+#include "utils.h"
+
+#include "../include/sequencing.h"
+#include "../include/actions.h"
+#include "../include/fusion_helper.h"
+
+#include <numeric>
+
+using namespace celerity;
+using namespace celerity::algorithm;
+using namespace celerity::algorithm::traits;
+using namespace celerity::algorithm::util;
+using namespace celerity::algorithm::aliases;
+
+SCENARIO("Fusing tasks reading chunks of their input", "[fusion::tiling]")
+{
+    celerity::distr_queue q{};
+
+    constexpr auto size = 100;
+
+    auto gen_i = [](cl::sycl::item<1> i) { return static_cast<int>(i.get_linear_id()); };
+    auto mul_2 = [](int x) { return x * 2; };
+    auto sum_3 = [](const chunk_i<3> &c) { return c.discern(0, [&]() { return c[{-1}] + *c + c[{1}]; }); };
+
+    GIVEN("A transform kernel and a transform kernel reading a chunk of its output")
+    {
+        buffer<int, 1> buf_in{{size}};
+        generate<class gen_i_1>(q, begin(buf_in), end(buf_in), gen_i);
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class mul_2_2>(mul_2);
+            auto t2 = transform<class sum_3_3>(sum_3);
+
+            auto seq = buf_in | t1 | t2;
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("kernels are fused and the sum of the neighbours is computed")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 2);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                REQUIRE(r[0] == 0);
+                REQUIRE(r[size - 1] == 0);
+
+                for (auto i = 1; i < size - 1; ++i)
+                {
+                    REQUIRE(r[i] == 6 * i);
+                }
+            }
+        }
+    }
+
+    GIVEN("A generate kernel and a transform kernel reading a two-dimensional chunk of its output")
+    {
+        constexpr auto rows = 10;
+        constexpr auto cols = 10;
+
+        auto gen_col = [](cl::sycl::item<2> i) { return static_cast<int>(i.get_id(1)); };
+        auto sum_3x3 = [](const chunk_i<3, 3> &c) {
+            return c.discern(0, [&]() {
+                auto sum = 0;
+
+                for (auto y = -1; y <= 1; ++y)
+                {
+                    for (auto x = -1; x <= 1; ++x)
+                    {
+                        sum += c[{y, x}];
+                    }
+                }
+
+                return sum;
+            });
+        };
+
+        WHEN("chaining calls")
+        {
+            auto t1 = generate_n<class gen_col_4>(cl::sycl::range<2>{rows, cols}, gen_col);
+            auto t2 = transform<class sum_3x3_5>(sum_3x3);
+
+            auto seq = t1 | t2;
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("kernels are fused and the sum of the neighbours is computed")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (auto y = 1; y < rows - 1; ++y)
+                {
+                    for (auto x = 1; x < cols - 1; ++x)
+                    {
+                        REQUIRE(r[y * cols + x] == 9 * x);
+                    }
+                }
+
+                for (auto x = 0; x < cols; ++x)
+                {
+                    REQUIRE(r[x] == 0);
+                    REQUIRE(r[(rows - 1) * cols + x] == 0);
+                }
+            }
+        }
+    }
+
+    GIVEN("Two transform kernels reading chunks of their input")
+    {
+        buffer<int, 1> buf_in{{size}};
+        generate<class gen_i_6>(q, begin(buf_in), end(buf_in), gen_i);
+
+        WHEN("chaining calls")
+        {
+            auto t1 = transform<class sum_3_7>(sum_3);
+            auto t2 = transform<class sum_3_8>(sum_3);
+            auto t3 = transform<class mul_2_9>(mul_2);
+
+            auto seq = buf_in | t1 | t2 | t3;
+
+            auto buf_out = seq | submit_to(q);
+
+            THEN("the first kernel is recomputed for the halo of the second one")
+            {
+                using seq_type = decltype(seq);
+
+                static_assert(size_v<linked_t<seq_type>> == 3);
+                static_assert(size_v<fused_t<seq_type>> == 1);
+
+                const auto r = copy_to_host(q, buf_out);
+
+                for (auto i = 2; i < size - 2; ++i)
+                {
+                    REQUIRE(r[i] == 18 * i);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Widening range mappers by the halo of a tile", "[fusion::tiling]")
+{
+    using namespace celerity::algorithm::detail;
+
+    GIVEN("A one-to-one range mapper")
+    {
+        const celerity::chunk<2> inner{{4, 4}, {2, 2}, {10, 10}};
+        const celerity::chunk<2> corner{{0, 8}, {2, 2}, {10, 10}};
+
+        WHEN("no tiled fusion is built")
+        {
+            const auto mapper = tiled<2>(celerity::access::one_to_one<2>{});
+
+            THEN("chunks are mapped to themselves")
+            {
+                const auto sr = mapper(inner);
+
+                REQUIRE(sr.offset == cl::sycl::id<2>{4, 4});
+                REQUIRE(sr.range == cl::sycl::range<2>{2, 2});
+            }
+        }
+
+        WHEN("the command group of a tiled fusion is built")
+        {
+            const tile_halo_scope<tile<int, 3, 5>> scope{};
+            const auto mapper = tiled<2>(celerity::access::one_to_one<2>{});
+
+            THEN("chunks are widened by the halo and clamped to the global range")
+            {
+                const auto sr = mapper(inner);
+
+                REQUIRE(sr.offset == cl::sycl::id<2>{3, 2});
+                REQUIRE(sr.range == cl::sycl::range<2>{4, 6});
+
+                const auto sr_corner = mapper(corner);
+
+                REQUIRE(sr_corner.offset == cl::sycl::id<2>{0, 6});
+                REQUIRE(sr_corner.range == cl::sycl::range<2>{3, 4});
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+
+#pragma clang diagnostic warning "-Wall"
+
+#define CELERITY_STD_ENABLE_PROFILING
+
+#include "utils.h"
+
+#include "../include/sequencing.h"
+#include "../include/actions.h"
+
+#include <numeric>
+#include <sstream>
+
+using namespace celerity;
+using namespace celerity::algorithm;
+
+namespace
+{
+
+stage_profile find_stage(const std::string &kernel_name)
+{
+    for (const auto &[name, profile] : profiler::instance().get_profiles())
+    {
+        if (name.size() >= kernel_name.size() && name.compare(name.size() - kernel_name.size(), kernel_name.size(), kernel_name) == 0)
+        {
+            return profile;
+        }
+    }
+
+    return {};
+}
+
+} // namespace
+
+SCENARIO("Profiling the stages of pipelines", "[profiling]")
+{
+    distr_queue q;
+
+    GIVEN("A one-dimensional buffer of a hundred 1s")
+    {
+        constexpr auto size = 100;
+
+        std::vector<int> src(size, 1);
+        buffer<int, 1> buf(src.data(), {size});
+
+        profiler::instance().reset();
+
+        WHEN("transforming the buffer twice in separate tasks")
+        {
+            buffer<int, 1> buf_out(buf.get_range());
+
+            transform<class profiled_add>(q, buf, buf_out, [](int x) { return x + 1; });
+            transform<class profiled_add>(q, buf, buf_out, [](int x) { return x + 1; });
+
+            // the executions are recorded by host tasks after the kernels
+            q.slow_full_sync();
+
+            THEN("both submissions are recorded with the input and output chunks as accessed bytes")
+            {
+                const auto profile = find_stage("profiled_add");
+
+                REQUIRE(profile.submissions == 2);
+                REQUIRE(profile.fused_submissions == 0);
+                REQUIRE(profile.accessed_bytes == 2 * 2 * size * sizeof(int));
+                REQUIRE(profile.submission_seconds >= 0);
+                REQUIRE(profile.completion_seconds >= 0);
+            }
+        }
+
+        WHEN("fusing two transformations")
+        {
+            auto buf_out = buf | transform<class profiled_first>([](int x) { return x + 5; }) | transform<class profiled_second>([](int x) { return x * 3; }) | submit_to(q);
+
+            q.slow_full_sync();
+
+            THEN("the fused kernel is attributed to both stages")
+            {
+                const auto first = find_stage("profiled_first");
+                const auto second = find_stage("profiled_second");
+
+                REQUIRE(first.submissions == 1);
+                REQUIRE(first.fused_submissions == 1);
+                REQUIRE(second.submissions == 1);
+                REQUIRE(second.fused_submissions == 1);
+
+                // the transient buffer between the stages is not accessed in global memory
+                REQUIRE(first.accessed_bytes + second.accessed_bytes == 2 * size * sizeof(int));
+            }
+
+            THEN("the report lists both stages")
+            {
+                std::ostringstream os;
+                profiler::instance().report(os);
+
+                REQUIRE(os.str().find("profiled_first") != std::string::npos);
+                REQUIRE(os.str().find("profiled_second") != std::string::npos);
+            }
+        }
+    }
+
+    GIVEN("A 4x4 matrix and a vector of four elements")
+    {
+        constexpr size_t rank = 4;
+
+        buffer<int, 2> mat(cl::sycl::range<2>{rank, rank});
+        buffer<int, 2> vec(cl::sycl::range<2>{rank, 1});
+
+        fill<class profiled_fill_mat>(q, begin(mat), end(mat), 1);
+        fill<class profiled_fill_vec>(q, begin(vec), end(vec), 2);
+
+        q.slow_full_sync();
+        profiler::instance().reset();
+
+        WHEN("multiplying them with slices of the matrix rows")
+        {
+            buffer<int, 2> out_vec(vec.get_range());
+
+            transform<class profiled_mul>(q, begin(vec), end(vec), begin(mat), begin(out_vec), [](const slice<int, 0> &v, const slice<int, 1> &a) {
+                return std::inner_product(begin(v), end(v), begin(a), 0);
+            });
+
+            q.slow_full_sync();
+
+            THEN("the accessed bytes are the ranges the accessors map the chunk to, not the launch size")
+            {
+                const auto profile = find_stage("profiled_mul");
+
+                REQUIRE(profile.submissions == 1);
+                REQUIRE(profile.accessed_bytes == (rank + rank * rank + rank) * sizeof(int));
+            }
+        }
+    }
+}
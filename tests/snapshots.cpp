@@ -0,0 +1,97 @@
+#define CATCH_CONFIG_MAIN
+
+#pragma clang diagnostic warning "-Wall"
+
+#include "utils.h"
+
+#include <algorithm>
+
+using namespace celerity;
+using namespace celerity::algorithm;
+
+SCENARIO("Taking snapshots of a buffer", "[algorithm::snapshot]")
+{
+    distr_queue q;
+
+    GIVEN("A two-dimensional buffer of 10x4 increasing numbers")
+    {
+        const auto src = indexed_elements(10 * 4, [](size_t i) { return static_cast<float>(i); });
+
+        buffer<float, 2> buf(src.data(), {10, 4});
+
+        WHEN("taking three snapshots in blocks of 3 rows while changing the buffer in between")
+        {
+            std::vector<size_t> indices;
+            std::vector<std::vector<float>> frames;
+
+            {
+                snapshot_writer<float> writer([&](size_t i, const char *bytes, size_t size) {
+                    indices.push_back(i);
+                    frames.emplace_back(reinterpret_cast<const float *>(bytes), reinterpret_cast<const float *>(bytes + size));
+                },
+                                              1);
+
+                for (auto i = 0; i < 3; ++i)
+                {
+                    snapshot(master(q), buf, writer, 3);
+                    transform<class snapshot_add_one>(q, begin(buf), end(buf), begin(buf), [](float x) { return x + 1; });
+                }
+
+                q.slow_full_sync();
+            }
+
+            THEN("every frame holds the buffer as it was when the snapshot was taken")
+            {
+                REQUIRE(indices == std::vector<size_t>{0, 1, 2});
+                REQUIRE(frames.size() == 3);
+
+                for (size_t i = 0; i < frames.size(); ++i)
+                {
+                    auto expected = src;
+                    std::for_each(begin(expected), end(expected), [i](float &x) { x += i; });
+
+                    REQUIRE(frames[i] == expected);
+                }
+            }
+        }
+
+        WHEN("taking delta compressed snapshots of a partially changing buffer")
+        {
+            std::vector<std::vector<char>> encoded;
+
+            {
+                snapshot_writer<float> writer([&](size_t, const char *bytes, size_t size) { encoded.emplace_back(bytes, bytes + size); },
+                                              2, snapshot_compression::delta);
+
+                snapshot(master(q), buf, writer);
+
+                auto beg = begin(buf);
+                beg += cl::sycl::id<2>{9, 0};
+                fill<class snapshot_fill_row>(q, beg, end(buf), -1.f);
+
+                snapshot(master(q), buf, writer);
+                snapshot(master(q), buf, writer);
+
+                q.slow_full_sync();
+                writer.flush();
+            }
+
+            THEN("the frames are restored in order and unchanged frames take less space")
+            {
+                REQUIRE(encoded.size() == 3);
+                REQUIRE(encoded[1].size() < src.size() * sizeof(float));
+                REQUIRE(encoded[2].size() < encoded[1].size());
+
+                snapshot_decoder<float> decode;
+
+                REQUIRE(decode(encoded[0].data(), encoded[0].size()) == src);
+
+                auto changed = src;
+                std::fill(begin(changed) + 36, end(changed), -1.f);
+
+                REQUIRE(decode(encoded[1].data(), encoded[1].size()) == changed);
+                REQUIRE(decode(encoded[2].data(), encoded[2].size()) == changed);
+            }
+        }
+    }
+}
@@ -27,11 +27,31 @@ CATCH_REGISTER_LISTENER(GlobalSetupAndTeardown)
 template <int Rank, typename T>
 std::vector<T> copy_to_host(celerity::distr_queue &q, celerity::buffer<T, Rank> &src)
 {
-    std::vector<int> dst(src.get_range().size(), 0);
+    std::vector<T> dst(src.get_range().size(), 0);
     celerity::algorithm::copy(celerity::algorithm::master_blocking(q), src, dst.data());
     return dst;
 }
 
+// the host elements a test buffer is created from, f maps the row-major index of an element to its value
+template <typename F>
+auto indexed_elements(size_t size, F f)
+{
+    std::vector<std::invoke_result_t<F, size_t>> elements(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        elements[i] = f(i);
+    }
+
+    return elements;
+}
+
+// the numbers 0 to size - 1
+inline std::vector<int> ascending_elements(size_t size)
+{
+    return indexed_elements(size, [](size_t i) { return static_cast<int>(i); });
+}
+
 template <auto Cmp>
 inline auto is_equal_to = [](const auto &x) { return x == Cmp; };
 